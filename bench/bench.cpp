@@ -0,0 +1,265 @@
+// Microbenchmarks of the engine's hot paths, build the windfall_bench target in release mode and run it
+// Every test prints its time per operation, the numbers are only comparable between runs on the same machine.
+
+// stlib
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// internal
+#include "tiny_ecs.hpp"
+#include "broad_phase.hpp"
+#include "worker_pool.hpp"
+
+// The component of the container benchmarks, about the size of a Motion
+struct BenchComponent
+{
+	float values[12] = {};
+};
+
+// The hash map backed container that ComponentContainer replaced, kept here as the baseline
+template <typename Component>
+class MapContainer
+{
+	std::unordered_map<unsigned int, unsigned int> map_entity_componentID;
+public:
+	std::vector<Component> components;
+	std::vector<Entity> entities;
+
+	Component& insert(Entity e, Component c)
+	{
+		map_entity_componentID[e] = (unsigned int)components.size();
+		components.push_back(std::move(c));
+		entities.push_back(e);
+		return components.back();
+	}
+
+	Component& get(Entity e)
+	{
+		return components[map_entity_componentID[e]];
+	}
+
+	bool has(Entity entity)
+	{
+		return map_entity_componentID.count(entity) > 0;
+	}
+
+	void remove(Entity e)
+	{
+		if (has(e))
+		{
+			unsigned int cID = map_entity_componentID[e];
+			components[cID] = std::move(components.back());
+			entities[cID] = entities.back();
+			map_entity_componentID[entities.back()] = cID;
+			map_entity_componentID.erase(e);
+			components.pop_back();
+			entities.pop_back();
+		}
+	}
+};
+
+// Keeps the optimizer from dropping the benchmarked loops
+static volatile float sink_value;
+
+// Runs func once and returns its time in nanoseconds per operation
+template <typename Func>
+static double time_per_op(size_t ops, Func func)
+{
+	auto start = std::chrono::high_resolution_clock::now();
+	func();
+	auto end = std::chrono::high_resolution_clock::now();
+	return std::chrono::duration<double, std::nano>(end - start).count() / (double)ops;
+}
+
+// insert all, has and get in random order with half of the queries missing, remove all in random order
+template <typename Container>
+static void bench_container(const char* label, const std::vector<Entity>& inserted, const std::vector<Entity>& queried)
+{
+	Container container;
+	size_t n = inserted.size();
+	double insert_ns = time_per_op(n, [&]() {
+		for (Entity e : inserted)
+			container.insert(e, BenchComponent());
+	});
+	double has_ns = time_per_op(queried.size(), [&]() {
+		unsigned int found = 0;
+		for (Entity e : queried)
+			found += container.has(e);
+		sink_value = (float)found;
+	});
+	double get_ns = time_per_op(n, [&]() {
+		float sum = 0.f;
+		for (size_t i = 0; i < n; i++)
+			sum += container.get(queried[2 * i]).values[0];
+		sink_value = sum;
+	});
+	double remove_ns = time_per_op(n, [&]() {
+		for (size_t i = 0; i < n; i++)
+			container.remove(queried[2 * i]);
+	});
+	printf("  %-10s insert %7.1f  has %7.1f  get %7.1f  remove %7.1f ns\n", label, insert_ns, has_ns, get_ns, remove_ns);
+}
+
+static void bench_containers()
+{
+	printf("Component containers, paged sparse set against the hash map\n");
+	std::mt19937 random(1);
+	for (size_t n : { 1000, 10000, 100000 })
+	{
+		// Entities with every other index, the queries mix them with the missing ones in between
+		std::vector<Entity> inserted, queried;
+		for (unsigned int i = 0; i < n; i++)
+		{
+			inserted.push_back(Entity(2 * i + 1, 0));
+			queried.push_back(Entity(2 * i + 1, 0));
+			queried.push_back(Entity(2 * i + 2, 0));
+		}
+		std::shuffle(inserted.begin(), inserted.end(), random);
+		// Shuffle pairs of (present, missing) so that the even positions stay the present entities
+		for (size_t i = n - 1; i > 0; i--)
+		{
+			size_t j = std::uniform_int_distribution<size_t>(0, i)(random);
+			std::swap(queried[2 * i], queried[2 * j]);
+			std::swap(queried[2 * i + 1], queried[2 * j + 1]);
+		}
+
+		printf(" %zu entities\n", n);
+		bench_container<ComponentContainer<BenchComponent>>("sparse set", inserted, queried);
+		bench_container<MapContainer<BenchComponent>>("hash map", inserted, queried);
+	}
+}
+
+// Bounding circles scattered over a square that fits 'n' of them at game density
+struct BenchBody
+{
+	vec2 center;
+	float radius;
+};
+
+static std::vector<BenchBody> scatter_bodies(size_t n, unsigned int seed)
+{
+	std::mt19937 random(seed);
+	float side = 60.f * std::sqrt((float)n);
+	std::uniform_real_distribution<float> coordinate(0.f, side), radius(10.f, 40.f);
+	std::vector<BenchBody> bodies(n);
+	for (BenchBody& body : bodies)
+	{
+		body.center = { coordinate(random), coordinate(random) };
+		body.radius = radius(random);
+	}
+	return bodies;
+}
+
+// The circle test of the collision pass, one centre lies within the other body's circle
+static bool circles_touch(const BenchBody& a, const BenchBody& b)
+{
+	vec2 dp = a.center - b.center;
+	float r = std::max(a.radius, b.radius);
+	return dot(dp, dp) <= r * r;
+}
+
+static void bench_broad_phase()
+{
+	printf("Broad phase, uniform grid against the all-pairs loop\n");
+	for (size_t n : { 100, 1000, 10000 })
+	{
+		std::vector<BenchBody> bodies = scatter_bodies(n, 2);
+
+		size_t all_pairs_hits = 0;
+		double all_pairs_ms = time_per_op(1, [&]() {
+			for (size_t i = 0; i < n; i++)
+				for (size_t j = 0; j < n; j++)
+					if (i != j && circles_touch(bodies[i], bodies[j]))
+						all_pairs_hits++;
+		}) / 1e6;
+
+		// The grid keeps its memory between steps, so a first step warms it up as in the game
+		BroadPhase broad_phase;
+		auto add_bodies = [&]() {
+			broad_phase.clear();
+			for (const BenchBody& body : bodies)
+				broad_phase.add(body.center, body.radius);
+		};
+		add_bodies();
+		broad_phase.find_pairs();
+		size_t candidates = 0, grid_hits = 0;
+		double grid_ms = time_per_op(1, [&]() {
+			add_bodies();
+			const std::vector<std::pair<unsigned int, unsigned int>>& pairs = broad_phase.find_pairs();
+			candidates = pairs.size();
+			for (const std::pair<unsigned int, unsigned int>& pair : pairs)
+				if (circles_touch(bodies[pair.first], bodies[pair.second]))
+					grid_hits++;
+		}) / 1e6;
+
+		printf(" %zu bodies\n", n);
+		printf("  all pairs  %9.3f ms  %zu tests, %zu overlapping\n", all_pairs_ms, n * (n - 1), all_pairs_hits);
+		printf("  grid       %9.3f ms  %zu candidates, %zu overlapping%s\n", grid_ms, candidates, grid_hits,
+			grid_hits == all_pairs_hits ? "" : "  MISMATCH");
+	}
+}
+
+// Broad phase and the circle test of its candidates on 1 to N threads, as the collision pass splits them
+// The pairs found by each chunk are merged in chunk order, so every thread count must give the same list.
+static void bench_thread_scaling(unsigned int max_threads)
+{
+	printf("Collision pass thread scaling\n");
+	static const size_t pair_grain = 512;
+	for (size_t n : { 10000, 50000 })
+	{
+		std::vector<BenchBody> bodies = scatter_bodies(n, 3);
+		printf(" %zu bodies\n", n);
+		std::vector<std::pair<unsigned int, unsigned int>> reference;
+		double single_ms = 0.0;
+		for (unsigned int threads = 1; threads <= max_threads; threads *= 2)
+		{
+			WorkerPool workers(threads);
+			BroadPhase broad_phase;
+			std::vector<std::vector<std::pair<unsigned int, unsigned int>>> chunk_hits;
+			std::vector<std::pair<unsigned int, unsigned int>> hits;
+			auto step = [&]() {
+				broad_phase.clear();
+				for (const BenchBody& body : bodies)
+					broad_phase.add(body.center, body.radius);
+				const std::vector<std::pair<unsigned int, unsigned int>>& candidates = broad_phase.find_pairs(&workers);
+				chunk_hits.resize(WorkerPool::chunk_count(candidates.size(), pair_grain));
+				workers.run(candidates.size(), pair_grain, [&](size_t chunk, size_t begin, size_t end) {
+					chunk_hits[chunk].clear();
+					for (size_t i = begin; i < end; i++)
+						if (circles_touch(bodies[candidates[i].first], bodies[candidates[i].second]))
+							chunk_hits[chunk].push_back(candidates[i]);
+				});
+				hits.clear();
+				for (const std::vector<std::pair<unsigned int, unsigned int>>& found : chunk_hits)
+					hits.insert(hits.end(), found.begin(), found.end());
+			};
+			// Warm up, the first job also starts the workers
+			step();
+			double ms = time_per_op(1, step) / 1e6;
+			if (threads == 1)
+			{
+				reference = hits;
+				single_ms = ms;
+			}
+			printf("  %2u threads %9.3f ms  speedup %5.2f  %zu overlapping%s\n", threads, ms, single_ms / ms, hits.size(),
+				hits == reference ? "" : "  MISMATCH");
+		}
+	}
+}
+
+// The optional argument is the largest thread count of the scaling test, one per hardware thread by default
+int main(int argc, char* argv[])
+{
+	unsigned int max_threads = argc > 1 ? (unsigned int)atoi(argv[1]) : std::thread::hardware_concurrency();
+	bench_containers();
+	bench_broad_phase();
+	bench_thread_scaling(std::max(max_threads, 1u));
+	return EXIT_SUCCESS;
+}
@@ -717,13 +717,7 @@ void BTIfPlayerSideDoNotHaveMageHardCoded::init(Entity e) {
 
 BTState BTIfPlayerSideDoNotHaveMageHardCoded::process(Entity e) {
 	printf("Checking if player side has no mage ... \n");	// print statement to visualize
-	int toggle = 0;
-	for (int i = 0; i < registry.companions.components.size(); i++) {	// checks player side for mage NOT WORKING
-		Entity E = registry.companions.entities[i];
-		if (registry.companions.get(E).companionType == MAGE) {
-			toggle = 1;
-		}
-	}
+	int toggle = registry.characters.any(Side::PLAYER, MAGE) ? 1 : 0;	// checks player side for mage NOT WORKING
 	if (toggle == 0) {	// if player side has no mage, execute child which is fireball
 		printf("Player side do not have mage \n");
 		return m_child->process(e);
@@ -743,13 +737,7 @@ void BTIfPlayerSideHasMageHardCoded::init(Entity e) {
 
 BTState BTIfPlayerSideHasMageHardCoded::process(Entity e) {
 	printf("Checking if player side has mage ... \n");	// print statement to visualize
-	int toggle = 0;
-	for (int i = 0; i < registry.companions.components.size(); i++) {	// checks player side for mage NOT WORKING
-		Entity toCheck = registry.companions.entities[i];
-		if (registry.companions.get(toCheck).companionType == MAGE) {
-			toggle = 1;
-		}
-	}
+	int toggle = registry.characters.any(Side::PLAYER, MAGE) ? 1 : 0;	// checks player side for mage NOT WORKING
 	if (toggle == 1) {	// if player side has mage, execute child which is check taunt (fireball for now)
 		printf("Player side indeed has mage \n");
 		return m_child->process(e);
@@ -770,12 +758,7 @@ void BTIfPlayerMageTaunted::init(Entity e) {
 BTState BTIfPlayerMageTaunted::process(Entity e) {
 	printf("If magician is taunted ... \n");	// print statement to visualize
 	// check if player mage is taunted
-	for (int i = 0; i < registry.companions.components.size(); i++) {
-		Entity toGet = registry.companions.entities[i];
-		if (registry.companions.get(toGet).companionType == MAGE) {	// only cast taunt on companion mage
-			target = toGet;
-		}
-	}
+	registry.characters.find_last(Side::PLAYER, MAGE, target);	// only cast taunt on companion mage
 	if (registry.taunts.has(target)) {
 		printf("Player mage is indeed taunted \n");
 		return m_child->process(e);
@@ -796,12 +779,7 @@ void BTIfPlayerMageNotTaunted::init(Entity e) {
 BTState BTIfPlayerMageNotTaunted::process(Entity e) {
 	printf("If player mage is not taunted ... \n");	// print statement to visualize
 	// check if player mage is taunted
-	for (int i = 0; i < registry.companions.components.size(); i++) {
-		Entity toGet = registry.companions.entities[i];
-		if (registry.companions.get(toGet).companionType == MAGE) {	// only cast taunt on companion mage
-			target = toGet;
-		}
-	}
+	registry.characters.find_last(Side::PLAYER, MAGE, target);	// only cast taunt on companion mage
 	if (!registry.taunts.has(target)) {
 		printf("Player mage is not taunted \n");
 		return m_child->process(e);
@@ -861,12 +839,7 @@ void BTIfEnemyMageTaunted::init(Entity e) {
 
 BTState BTIfEnemyMageTaunted::process(Entity e) {
 	printf("Checking if enemy mage is taunted ... \n");	// print statement to visualize
-	for (int i = 0; i < registry.enemies.components.size(); i++) {
-		Entity toGet = registry.enemies.entities[i];
-		if (registry.enemies.get(toGet).enemyType == MAGE) {
-			target = toGet;
-		}
-	}
+	registry.characters.find_last(Side::ENEMY, MAGE, target);
 	if (registry.taunts.has(target)) {
 		printf("Enemy mage is indeed taunted \n");
 		return m_child->process(e);
@@ -887,12 +860,7 @@ void BTIfEnemyMageNotTaunted::init(Entity e) {
 
 BTState BTIfEnemyMageNotTaunted::process(Entity e) {
 	printf("Checking if enemy mage is taunted ... \n");	// print statement to visualize
-	for (int i = 0; i < registry.enemies.components.size(); i++) {
-		Entity toGet = registry.enemies.entities[i];
-		if (registry.enemies.get(toGet).enemyType == MAGE) {
-			target = toGet;
-		}
-	}
+	registry.characters.find_last(Side::ENEMY, MAGE, target);
 	if (!registry.taunts.has(target)) {
 		printf("Enemy mage is not taunted \n");
 		return m_child->process(e);
@@ -913,12 +881,7 @@ void BTIfNecroOneTaunted::init(Entity e) {
 
 BTState BTIfNecroOneTaunted::process(Entity e) {
 	printf("Checking if necromancer one is taunted ... \n");	// print statement to visualize
-	for (int i = 0; i < registry.enemies.components.size(); i++) {
-		Entity toGet = registry.enemies.entities[i];
-		if (registry.enemies.get(toGet).enemyType == NECROMANCER_ONE) {
-			target = toGet;
-		}
-	}
+	registry.characters.find_last(Side::ENEMY, NECROMANCER_ONE, target);
 	if (registry.taunts.has(target)) {
 		printf("Necromancer One is indeed taunted \n");
 		return m_child->process(e);
@@ -939,12 +902,7 @@ void BTIfNecroOneNotTaunted::init(Entity e) {
 
 BTState BTIfNecroOneNotTaunted::process(Entity e) {
 	printf("Checking if necromancer one is taunted ... \n");	// print statement to visualize
-	for (int i = 0; i < registry.enemies.components.size(); i++) {
-		Entity toGet = registry.enemies.entities[i];
-		if (registry.enemies.get(toGet).enemyType == NECROMANCER_ONE) {
-			target = toGet;
-		}
-	}
+	registry.characters.find_last(Side::ENEMY, NECROMANCER_ONE, target);
 	if (!registry.taunts.has(target)) {
 		printf("Necromancer One is not taunted \n");
 		return m_child->process(e);
@@ -965,12 +923,7 @@ void BTIfNecroTwoTaunted::init(Entity e) {
 
 BTState BTIfNecroTwoTaunted::process(Entity e) {
 	printf("Checking if necromancer two is taunted ... \n");	// print statement to visualize
-	for (int i = 0; i < registry.enemies.components.size(); i++) {
-		Entity toGet = registry.enemies.entities[i];
-		if (registry.enemies.get(toGet).enemyType == NECROMANCER_TWO) {
-			target = toGet;
-		}
-	}
+	registry.characters.find_last(Side::ENEMY, NECROMANCER_TWO, target);
 	if (registry.taunts.has(target)) {
 		printf("Necromancer Two is indeed taunted \n");
 		return m_child->process(e);
@@ -991,12 +944,7 @@ void BTIfNecroTwoNotTaunted::init(Entity e) {
 
 BTState BTIfNecroTwoNotTaunted::process(Entity e) {
 	printf("Checking if necromancer two is taunted ... \n");	// print statement to visualize
-	for (int i = 0; i < registry.enemies.components.size(); i++) {
-		Entity toGet = registry.enemies.entities[i];
-		if (registry.enemies.get(toGet).enemyType == NECROMANCER_TWO) {
-			target = toGet;
-		}
-	}
+	registry.characters.find_last(Side::ENEMY, NECROMANCER_TWO, target);
 	if (!registry.taunts.has(target)) {
 		printf("Necromancer Two is not taunted \n");
 		return m_child->process(e);
@@ -1016,15 +964,7 @@ void BTIfAtLeastOneLessThanHalf::init(Entity e) {
 }
 
 BTState BTIfAtLeastOneLessThanHalf::process(Entity e) {
-	int toggle = 0;
-	for (int i = 0; i < registry.enemies.components.size(); i++) {
-		Entity currEntity = registry.enemies.entities[i];
-		int currHealth = registry.stats.get(currEntity).health;
-		int halfHealth = registry.stats.get(currEntity).max_health / 2;
-		if (currHealth < halfHealth) {
-			toggle = 1;
-		}
-	}
+	int toggle = registry.characters.below_half_health(Side::ENEMY) > 0 ? 1 : 0;
 	printf("Checking if at least one is less than half HP ... \n");	// print statement to visualize
 	printf("Check health toggle = %g \n", float(toggle));
 	if (toggle == 1) {
@@ -1046,15 +986,7 @@ void BTIfNoneLessThanHalf::init(Entity e) {
 }
 
 BTState BTIfNoneLessThanHalf::process(Entity e) {
-	int toggle = 0;
-	for (int i = 0; i < registry.enemies.components.size(); i++) {
-		Entity currEntity = registry.enemies.entities[i];
-		int currHealth = registry.stats.get(currEntity).health;
-		int halfHealth = registry.stats.get(currEntity).max_health / 2;
-		if (currHealth < halfHealth) {
-			toggle = 1;
-		}
-	}
+	int toggle = registry.characters.below_half_health(Side::ENEMY) > 0 ? 1 : 0;
 	printf("Checking if no characters have less than half HP ... \n");	// print statement to visualize
 	if (toggle == 0) {
 		printf("There is no characters with less than half HP \n");
@@ -1126,13 +1058,7 @@ void BTIfPlayerSideHasSwordsman::init(Entity e) {
 
 BTState BTIfPlayerSideHasSwordsman::process(Entity e) {
 	printf("Checking if player side has swordsman ... \n");	// print statement to visualize
-	int toggle = 0;
-	for (int i = 0; i < registry.companions.components.size(); i++) {	// checks player side for mage
-		Entity toCheck = registry.companions.entities[i];
-		if (registry.companions.get(toCheck).companionType == SWORDSMAN) {
-			toggle = 1;
-		}
-	}
+	int toggle = registry.characters.any(Side::PLAYER, SWORDSMAN) ? 1 : 0;	// checks player side for mage
 	if (toggle == 1) {	// if player side has mage, execute child which is check taunt (fireball for now)
 		printf("Player side indeed has swordsman \n");
 		return m_child->process(e);
@@ -1152,13 +1078,7 @@ void BTIfPlayerSideDoNotHaveSwordsman::init(Entity e) {
 
 BTState BTIfPlayerSideDoNotHaveSwordsman::process(Entity e) {
 	printf("Checking if player side has swordsman ... \n");	// print statement to visualize
-	int toggle = 0;
-	for (int i = 0; i < registry.companions.components.size(); i++) {
-		Entity toCheck = registry.companions.entities[i];
-		if (registry.companions.get(toCheck).companionType == SWORDSMAN) {
-			toggle = 1;
-		}
-	}
+	int toggle = registry.characters.any(Side::PLAYER, SWORDSMAN) ? 1 : 0;
 	if (toggle == 0) {	// if player side has mage, execute child which is check taunt (fireball for now)
 		printf("Player side do not have swordsman \n");
 		return m_child->process(e);
@@ -1178,12 +1098,7 @@ void BTIfEnemySwordsmanNotTaunted::init(Entity e) {
 
 BTState BTIfEnemySwordsmanNotTaunted::process(Entity e) {
 	printf("Checking if enemy swordsman is taunted ... \n");	// print statement to visualize
-	for (int i = 0; i < registry.enemies.components.size(); i++) {
-		Entity toGet = registry.enemies.entities[i];
-		if (registry.enemies.get(toGet).enemyType == SWORDSMAN) {
-			target = toGet;
-		}
-	}
+	registry.characters.find_last(Side::ENEMY, SWORDSMAN, target);
 	if (!registry.taunts.has(target)) {
 		printf("Enemy swordsman is not taunted \n");
 		return m_child->process(e);
@@ -1204,12 +1119,7 @@ void BTIfEnemySwordsmanTaunted::init(Entity e) {
 
 BTState BTIfEnemySwordsmanTaunted::process(Entity e) {
 	printf("Checking if enemy swordsman is taunted ... \n");	// print statement to visualize
-	for (int i = 0; i < registry.enemies.components.size(); i++) {
-		Entity toGet = registry.enemies.entities[i];
-		if (registry.enemies.get(toGet).enemyType == SWORDSMAN) {
-			target = toGet;
-		}
-	}
+	registry.characters.find_last(Side::ENEMY, SWORDSMAN, target);
 	if (registry.taunts.has(target)) {
 		printf("Enemy swordsman is indeed taunted \n");
 		return m_child->process(e);
@@ -1318,13 +1228,7 @@ void BTIfHasNecroMinion::init(Entity e) {
 
 BTState BTIfHasNecroMinion::process(Entity e) {
 	printf("Checking if enemy side has necro minion ... \n");	// print statement to visualize
-	int toggle = 0;
-	for (int i = 0; i < registry.enemies.components.size(); i++) {	// checks enemy side for necromancer minion
-		Entity E = registry.enemies.entities[i];
-		if (registry.enemies.get(E).enemyType == NECROMANCER_MINION) {
-			toggle = 1;
-		}
-	}
+	int toggle = registry.characters.any(Side::ENEMY, NECROMANCER_MINION) ? 1 : 0;	// checks enemy side for necromancer minion
 	if (toggle == 1) {	// if player side has necromancer minion, execute child which is check mage
 		printf("Enemy side indeed has necro minion \n");
 		return m_child->process(e);
@@ -1345,13 +1249,7 @@ void BTIfNoNecroMinion::init(Entity e) {
 
 BTState BTIfNoNecroMinion::process(Entity e) {
 	printf("Checking if enemy side has necro minion ... \n");	// print statement to visualize
-	int toggle = 0;
-	for (int i = 0; i < registry.enemies.components.size(); i++) {	// checks enemy side for necromancer minion
-		Entity E = registry.enemies.entities[i];
-		if (registry.enemies.get(E).enemyType == NECROMANCER_MINION) {
-			toggle = 1;
-		}
-	}
+	int toggle = registry.characters.any(Side::ENEMY, NECROMANCER_MINION) ? 1 : 0;	// checks enemy side for necromancer minion
 	if (toggle == 0) {	// if player side does not have necromancer minion, execute child which is summon necromancer minion
 		printf("Enemy side does not have necro minion \n");
 		return m_child->process(e);
@@ -1373,12 +1271,7 @@ void BTIfPlayerMageSilenced::init(Entity e) {
 BTState BTIfPlayerMageSilenced::process(Entity e) {
 	printf("Checking if player mage is silenced ... \n");	// print statement to visualize
 	// check if player mage is silenced
-	for (int i = 0; i < registry.companions.components.size(); i++) {
-		Entity toGet = registry.companions.entities[i];
-		if (registry.companions.get(toGet).companionType == MAGE) {	// only cast taunt on companion mage
-			target = toGet;
-		}
-	}
+	registry.characters.find_last(Side::PLAYER, MAGE, target);	// only cast taunt on companion mage
 	if (registry.silenced.has(target)) {
 		printf("Player mage is not silenced \n");
 		return m_child->process(e);
@@ -1400,12 +1293,7 @@ void BTIfPlayerMageNotSilenced::init(Entity e) {
 BTState BTIfPlayerMageNotSilenced::process(Entity e) {
 	printf("Checking if player mage is silenced ... \n");	// print statement to visualize
 	// check if player mage is silenced
-	for (int i = 0; i < registry.companions.components.size(); i++) {
-		Entity toGet = registry.companions.entities[i];
-		if (registry.companions.get(toGet).companionType == MAGE) {	// only cast taunt on companion mage
-			target = toGet;
-		}
-	}
+	registry.characters.find_last(Side::PLAYER, MAGE, target);	// only cast taunt on companion mage
 	if (!registry.silenced.has(target)) {
 		printf("Player mage is not silenced \n");
 		return m_child->process(e);
@@ -1446,12 +1334,7 @@ void BTIfUltiTurn::init(Entity e) {
 
 BTState BTIfUltiTurn::process(Entity e) {
 	printf("Checking if it is ultimate's turn ... \n");	// print statement to visualize
-	for (int i = 0; i < registry.enemies.components.size(); i++) {
-		Entity toGet = registry.enemies.entities[i];
-		if (registry.enemies.get(toGet).enemyType == NECROMANCER_TWO) {	// only necromancer two using ulti
-			target = toGet;
-		}
-	}
+	registry.characters.find_last(Side::ENEMY, NECROMANCER_TWO, target);	// only necromancer two using ulti
 	if (!registry.ultimate.has(target)) {
 		printf("It is indeed ultimate's turn \n");
 		return m_child->process(e);
@@ -1472,12 +1355,7 @@ void BTIfNotUltiTurn::init(Entity e) {
 
 BTState BTIfNotUltiTurn::process(Entity e) {
 	printf("Checking if it is ultimate's turn ... \n");	// print statement to visualize
-	for (int i = 0; i < registry.enemies.components.size(); i++) {
-		Entity toGet = registry.enemies.entities[i];
-		if (registry.enemies.get(toGet).enemyType == NECROMANCER_TWO) {	// only necromancer two using ulti
-			target = toGet;
-		}
-	}
+	registry.characters.find_last(Side::ENEMY, NECROMANCER_TWO, target);	// only necromancer two using ulti
 	if (registry.ultimate.has(target)) {
 		printf("It is not ultimate's turn \n");
 		return m_child->process(e);
@@ -1542,12 +1420,7 @@ void BTIfShieldTurn::init(Entity e) {
 
 BTState BTIfShieldTurn::process(Entity e) {
 	printf("Checking if it is shield turn ... \n");	// print statement to visualize
-	for (int i = 0; i < registry.enemies.components.size(); i++) {
-		Entity toGet = registry.enemies.entities[i];
-		if (registry.enemies.get(toGet).enemyType == NECROMANCER_TWO) {	// only necromancer two using shield
-			target = toGet;
-		}
-	}
+	registry.characters.find_last(Side::ENEMY, NECROMANCER_TWO, target);	// only necromancer two using shield
 	if (!registry.shield.has(target)) {
 		printf("It is indeed shield turn \n");
 		return m_child->process(e);
@@ -1568,12 +1441,7 @@ void BTIfNotShieldTurn::init(Entity e) {
 
 BTState BTIfNotShieldTurn::process(Entity e) {
 	printf("Checking if it is not shield turn ... \n");	// print statement to visualize
-	for (int i = 0; i < registry.enemies.components.size(); i++) {
-		Entity toGet = registry.enemies.entities[i];
-		if (registry.enemies.get(toGet).enemyType == NECROMANCER_TWO) {	// only necromancer two using shield
-			target = toGet;
-		}
-	}
+	registry.characters.find_last(Side::ENEMY, NECROMANCER_TWO, target);	// only necromancer two using shield
 	if (registry.shield.has(target)) {
 		printf("It is not shield turn \n");
 		return m_child->process(e);
@@ -1640,12 +1508,7 @@ void BTCastTauntOnMage::init(Entity e) {
 BTState BTCastTauntOnMage::process(Entity e) {
 	SkillSystem sk;
 	printf("Cast Taunt \n\n");	// print statement to visualize
-	for (int i = 0; i < registry.companions.components.size(); i++) {
-		Entity toGet = registry.companions.entities[i];
-		if (registry.companions.get(toGet).companionType == MAGE) {	// only cast taunt on companion mage
-			target = toGet;
-		}
-	}
+	registry.characters.find_last(Side::PLAYER, MAGE, target);	// only cast taunt on companion mage
 	sk.startTauntAttack(e, target);
 
 	// return progress
@@ -1677,12 +1540,7 @@ void BTMeleeAttackOnSwordsman::init(Entity e) {
 BTState BTMeleeAttackOnSwordsman::process(Entity e) {
 	int j = 0;
 	SkillSystem sk;
-	for (int i = 0; i < registry.companions.components.size(); i++) {
-		Entity toGet = registry.companions.entities[i];
-		if (registry.companions.get(toGet).companionType == SWORDSMAN) {
-			target = toGet;
-		}
-	}
+	registry.characters.find_last(Side::PLAYER, SWORDSMAN, target);
 	sk.startMeleeAttack(e, target, -1);
 
 	printf("Melee Attack \n\n");	// print statement to visualize
@@ -1695,12 +1553,7 @@ void BTCastRockOnSwordsman::init(Entity e) {
 }
 BTState BTCastRockOnSwordsman::process(Entity e) {
 	SkillSystem sk;
-	for (int i = 0; i < registry.companions.components.size(); i++) {
-		Entity toGet = registry.companions.entities[i];
-		if (registry.companions.get(toGet).companionType == SWORDSMAN) {
-			target = toGet;
-		}
-	}
+	registry.characters.find_last(Side::PLAYER, SWORDSMAN, target);
 	sk.startRockAttack(e, target);
 	printf("Cast Rock On Swordsman\n\n");	// print statement to visualize
 
@@ -1712,12 +1565,7 @@ void BTCastRockOnMage::init(Entity e) {
 }
 BTState BTCastRockOnMage::process(Entity e) {
 	SkillSystem sk;
-	for (int i = 0; i < registry.companions.components.size(); i++) {
-		Entity toGet = registry.companions.entities[i];
-		if (registry.companions.get(toGet).companionType == MAGE) {
-			target = toGet;
-		}
-	}
+	registry.characters.find_last(Side::PLAYER, MAGE, target);
 	sk.startRockAttack(e, target);
 	printf("Cast Rock On Mage\n\n");	// print statement to visualize
 
@@ -1728,15 +1576,10 @@ BTState BTCastRockOnMage::process(Entity e) {
 void BTCastHealOnLowestHP::init(Entity e) {
 }
 BTState BTCastHealOnLowestHP::process(Entity e) {
-	int lowestHealth = 100;
 	SkillSystem sk;
-	for (int i = 0; i < registry.enemies.components.size(); i++) {
-		Entity toGet = registry.enemies.entities[i];
-		int currHealth = registry.stats.get(toGet).health;
-		if (currHealth < lowestHealth) {
-			lowestHealth = currHealth;
-			target = toGet;
-		}
+	Entity lowest = registry.characters.lowest_health(Side::ENEMY);
+	if (lowest != Entity() && registry.stats.get(lowest).health < 100) {
+		target = lowest;
 	}
 	sk.startHealAttack(e, target);
 
@@ -1750,12 +1593,7 @@ void BTCastHealOnSelf::init(Entity e) {
 }
 BTState BTCastHealOnSelf::process(Entity e) {
 	SkillSystem sk;
-	for (int i = 0; i < registry.enemies.components.size(); i++) {
-		Entity toGet = registry.enemies.entities[i];
-		if (registry.enemies.get(toGet).enemyType == MAGE) {
-			target = toGet;
-		}
-	}
+	registry.characters.find_last(Side::ENEMY, MAGE, target);
 	sk.startHealAttack(e, target);
 	printf("Cast Heal On Self \n\n");	// print statement to visualize
 
@@ -1789,12 +1627,7 @@ void BTCastSilence::init(Entity e) {
 BTState BTCastSilence::process(Entity e) {
 	SkillSystem sk;
 	printf("Cast Silence \n\n");
-	for (int i = 0; i < registry.companions.components.size(); i++) {
-		Entity toGet = registry.companions.entities[i];
-		if (registry.companions.get(toGet).companionType == MAGE) {
-			target = toGet;
-		}
-	}
+	registry.characters.find_last(Side::PLAYER, MAGE, target);
 	sk.startSilenceAttack(e, target);
 
 	// return progress
@@ -1818,12 +1651,7 @@ BTState BTRandomTargetLightningAttack::process(Entity e) {
 void BTLightningAttackOnSwordsman::init(Entity e) {
 }
 BTState BTLightningAttackOnSwordsman::process(Entity e) {
-	for (int i = 0; i < registry.companions.components.size(); i++) {
-		Entity toGet = registry.companions.entities[i];
-		if (registry.companions.get(toGet).companionType == SWORDSMAN) {
-			target = toGet;
-		}
-	}
+	registry.characters.find_last(Side::PLAYER, SWORDSMAN, target);
 	SkillSystem sk;
 	sk.startLightningAttack(e, target);
 	printf("Cast Random Target Lightning Attack \n\n");
@@ -1914,12 +1742,7 @@ BTState BTCastSingleTargetAttackOnSwordsman::process(Entity e) {
 	printf("Cast Single Target Attack \n\n");
 	int j = 0;
 	SkillSystem sk;	// FOR TESTING TO REMOVE
-	for (int i = 0; i < registry.companions.components.size(); i++) {
-		Entity toGet = registry.companions.entities[i];
-		if (registry.companions.get(toGet).companionType == SWORDSMAN) {
-			target = toGet;
-		}
-	}
+	registry.characters.find_last(Side::PLAYER, SWORDSMAN, target);
 	sk.startMeleeAttack(e, target, 0);
 	// return progress
 	return BTState::Success;
@@ -0,0 +1,149 @@
+// internal
+#include "broad_phase.hpp"
+
+// stlib
+#include <algorithm>
+#include <cmath>
+
+// Cells are addressed by 32 bit coordinates, bodies further out are treated as unbounded
+static const double max_cell_coordinate = 1e9;
+
+// Grid size used when no body gives a usable diameter
+static const float default_cell_size = 64.f;
+
+static long long cell_key(long long x, long long y)
+{
+	return (x << 32) ^ (y & 0xffffffffLL);
+}
+
+void BroadPhase::set_cell_size(float size)
+{
+	fixed_cell_size = size;
+}
+
+void BroadPhase::clear()
+{
+	bodies.clear();
+	active_count = 0;
+}
+
+void BroadPhase::add(vec2 center, float radius, bool test_all, bool passive)
+{
+	bodies.push_back({ center, radius, test_all, passive });
+	if (!passive)
+		active_count++;
+}
+
+size_t BroadPhase::size() const
+{
+	return bodies.size();
+}
+
+// Bodies per chunk of the cell search when it is split across threads
+static const size_t search_grain = 256;
+
+static void add_pair(std::vector<std::pair<unsigned int, unsigned int>>& pairs, unsigned int a, unsigned int b)
+{
+	pairs.emplace_back(a, b);
+	pairs.emplace_back(b, a);
+}
+
+void BroadPhase::search_cells(float cell_size, unsigned int begin, unsigned int end,
+	std::vector<std::pair<unsigned int, unsigned int>>& found, std::vector<unsigned int>& found_unbounded) const
+{
+	for (unsigned int i = begin; i < end; i++)
+	{
+		const Body& body = bodies[i];
+		if (body.test_all)
+			continue;
+		// A small margin keeps rounding in the callers' exact distance test from losing a pair on a cell border
+		double radius = std::abs((double)body.radius) * 1.001 + 1e-3;
+		double x0 = std::floor((body.center.x - radius) / cell_size), x1 = std::floor((body.center.x + radius) / cell_size);
+		double y0 = std::floor((body.center.y - radius) / cell_size), y1 = std::floor((body.center.y + radius) / cell_size);
+		double covered = (x1 - x0 + 1.0) * (y1 - y0 + 1.0);
+		if (!(covered <= (double)cells.size()) || !(std::abs(x0) < max_cell_coordinate) || !(std::abs(x1) < max_cell_coordinate)
+			|| !(std::abs(y0) < max_cell_coordinate) || !(std::abs(y1) < max_cell_coordinate))
+		{
+			// Cheaper to test against everything than to visit the cells
+			found_unbounded.push_back(i);
+			continue;
+		}
+		for (long long x = (long long)x0; x <= (long long)x1; x++)
+			for (long long y = (long long)y0; y <= (long long)y1; y++)
+			{
+				long long key = cell_key(x, y);
+				auto it = std::lower_bound(cells.begin(), cells.end(), std::make_pair(key, 0u));
+				for (; it != cells.end() && it->first == key; ++it)
+					if (it->second != i && !(body.passive && bodies[it->second].passive))
+						add_pair(found, i, it->second);
+			}
+	}
+}
+
+const std::vector<std::pair<unsigned int, unsigned int>>& BroadPhase::find_pairs(WorkerPool* workers)
+{
+	pairs.clear();
+	cells.clear();
+	unbounded.clear();
+	// Nothing moved, so there is nothing new to find
+	if (active_count == 0)
+		return pairs;
+
+	float cell_size = fixed_cell_size;
+	if (cell_size <= 0.f)
+	{
+		double diameters = 0.0;
+		size_t counted = 0;
+		for (const Body& body : bodies)
+			if (!body.test_all && std::isfinite(body.radius))
+			{
+				diameters += 2.0 * body.radius;
+				counted++;
+			}
+		cell_size = counted > 0 ? (float)(diameters / counted) : 0.f;
+		if (!(cell_size > 0.f))
+			cell_size = default_cell_size;
+	}
+
+	// File the centres
+	for (unsigned int i = 0; i < bodies.size(); i++)
+	{
+		const Body& body = bodies[i];
+		double x = std::floor(body.center.x / cell_size);
+		double y = std::floor(body.center.y / cell_size);
+		if (body.test_all || !std::isfinite(body.radius) || !(std::abs(x) < max_cell_coordinate) || !(std::abs(y) < max_cell_coordinate))
+			unbounded.push_back(i);
+		else
+			cells.emplace_back(cell_key((long long)x, (long long)y), i);
+	}
+	std::sort(cells.begin(), cells.end());
+
+	// Look for centres within the cells covered by each circle
+	if (workers)
+	{
+		size_t chunks = WorkerPool::chunk_count(bodies.size(), search_grain);
+		chunk_pairs.resize(std::max(chunk_pairs.size(), chunks));
+		chunk_unbounded.resize(std::max(chunk_unbounded.size(), chunks));
+		workers->run(bodies.size(), search_grain, [&](size_t chunk, size_t begin, size_t end) {
+			chunk_pairs[chunk].clear();
+			chunk_unbounded[chunk].clear();
+			search_cells(cell_size, (unsigned int)begin, (unsigned int)end, chunk_pairs[chunk], chunk_unbounded[chunk]);
+		});
+		for (size_t chunk = 0; chunk < chunks; chunk++)
+		{
+			pairs.insert(pairs.end(), chunk_pairs[chunk].begin(), chunk_pairs[chunk].end());
+			unbounded.insert(unbounded.end(), chunk_unbounded[chunk].begin(), chunk_unbounded[chunk].end());
+		}
+	}
+	else
+		search_cells(cell_size, 0, (unsigned int)bodies.size(), pairs, unbounded);
+
+	for (unsigned int i : unbounded)
+		for (unsigned int j = 0; j < bodies.size(); j++)
+			if (j != i && !(bodies[i].passive && bodies[j].passive))
+				add_pair(pairs, i, j);
+
+	std::sort(pairs.begin(), pairs.end());
+	pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+	return pairs;
+}
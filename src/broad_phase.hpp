@@ -0,0 +1,55 @@
+#pragma once
+
+#include <vector>
+#include <utility>
+
+#include "common.hpp"
+#include "worker_pool.hpp"
+
+// Uniform grid broad phase, reports the pairs of bodies whose bounding circles may overlap
+// Every body is filed under the grid cell of its centre and looks for partners in the cells its circle covers, so
+// a pair is found whenever one centre lies within the other body's circle. Bodies added with 'test_all', with a
+// non-finite position, or whose circle covers more cells than there are bodies pair with every other body.
+// Passive bodies (resting or static ones) are only paired with active ones, the caller knows how passive pairs stand.
+class BroadPhase
+{
+public:
+	// Edge length of the grid cells, 0 uses the mean body diameter of each find_pairs
+	void set_cell_size(float size);
+
+	// Remove all bodies, the memory is kept for the next step
+	void clear();
+
+	// Add the body with number size() and the given bounding circle
+	void add(vec2 center, float radius, bool test_all = false, bool passive = false);
+
+	size_t size() const;
+
+	// Ordered pairs (i, j), i != j, of bodies that may overlap, with both orders of every pair, sorted by i then j
+	// With 'workers', the bodies look for their partners in parallel, the result is the same
+	const std::vector<std::pair<unsigned int, unsigned int>>& find_pairs(WorkerPool* workers = nullptr);
+
+private:
+	struct Body
+	{
+		vec2 center;
+		float radius;
+		bool test_all;
+		bool passive;
+	};
+
+	float fixed_cell_size = 0.f;
+	std::vector<Body> bodies;
+	size_t active_count = 0;
+	// (cell key, body) for the centre of every body on the grid, sorted by key
+	std::vector<std::pair<long long, unsigned int>> cells;
+	std::vector<unsigned int> unbounded;
+	std::vector<std::pair<unsigned int, unsigned int>> pairs;
+	// Pairs and unbounded bodies found by each chunk of bodies, appended to the above in chunk order
+	std::vector<std::vector<std::pair<unsigned int, unsigned int>>> chunk_pairs;
+	std::vector<std::vector<unsigned int>> chunk_unbounded;
+
+	// Look for the partners of bodies [begin, end) in the grid
+	void search_cells(float cell_size, unsigned int begin, unsigned int end,
+		std::vector<std::pair<unsigned int, unsigned int>>& found, std::vector<unsigned int>& found_unbounded) const;
+};
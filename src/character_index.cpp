@@ -0,0 +1,147 @@
+// internal
+#include "character_index.hpp"
+
+const std::vector<Entity> CharacterIndex::none;
+
+CharacterIndex::CharacterIndex(ComponentContainer<Companion>& companions, ComponentContainer<Enemy>& enemies,
+	ComponentContainer<Statistics>& stats, ComponentContainer<Motion>& motions, ComponentContainer<DeathTimer>& deathTimers)
+	: companions(companions), enemies(enemies), stats(stats), motions(motions), deathTimers(deathTimers)
+{
+}
+
+void CharacterIndex::add(Side side, Entity e, int type)
+{
+	int s = (int)side;
+	if (type >= 0 && type < type_count)
+		by_type[s][type].push_back(e);
+	members[s].push_back(e);
+	if (!deathTimers.has(e))
+		alive[s].push_back(e);
+	if (e.index() >= types.size())
+		types.resize(e.index() + 1);
+	types[e.index()] = std::make_pair(e, type);
+}
+
+void CharacterIndex::refresh()
+{
+	unsigned int current[3] = { companions.structure_version(), enemies.structure_version(), deathTimers.structure_version() };
+	if (std::equal(current, current + 3, versions))
+		return;
+	std::copy(current, current + 3, versions);
+
+	for (int s = 0; s < 2; s++)
+	{
+		for (std::vector<Entity>& list : by_type[s])
+			list.clear();
+		members[s].clear();
+		alive[s].clear();
+	}
+	types.clear();
+	for (unsigned int i = 0; i < companions.size(); i++)
+		add(Side::PLAYER, companions.entities[i], companions.components[i].companionType);
+	for (unsigned int i = 0; i < enemies.size(); i++)
+		add(Side::ENEMY, enemies.entities[i], enemies.components[i].enemyType);
+
+	// The members changed, so do the health aggregates
+	health_tick = ~0u;
+}
+
+void CharacterIndex::refresh_health()
+{
+	refresh();
+	if (health_tick == stats.current_tick() && health_version == stats.structure_version())
+		return;
+	health_tick = stats.current_tick();
+	health_version = stats.structure_version();
+
+	for (int s = 0; s < 2; s++)
+	{
+		lowest[s] = Entity();
+		below_half[s] = 0;
+		int lowest_value = 0;
+		for (Entity e : members[s])
+		{
+			if (!stats.has(e))
+				continue;
+			const Statistics& stat = stats.get(e);
+			if (lowest[s] == Entity() || stat.health < lowest_value)
+			{
+				lowest[s] = e;
+				lowest_value = stat.health;
+			}
+			if (stat.health < stat.max_health / 2)
+				below_half[s]++;
+		}
+	}
+}
+
+const std::vector<Entity>& CharacterIndex::of(Side side, int type)
+{
+	refresh();
+	if (type < 0 || type >= type_count)
+		return none;
+	return by_type[(int)side][type];
+}
+
+bool CharacterIndex::any(Side side, int type)
+{
+	return !of(side, type).empty();
+}
+
+bool CharacterIndex::find_last(Side side, int type, Entity& found)
+{
+	const std::vector<Entity>& list = of(side, type);
+	if (list.empty())
+		return false;
+	found = list.back();
+	return true;
+}
+
+int CharacterIndex::type_of(Entity e)
+{
+	refresh();
+	if (e.index() >= types.size() || types[e.index()].first != e)
+		return 0;
+	return types[e.index()].second;
+}
+
+size_t CharacterIndex::alive_count(Side side)
+{
+	refresh();
+	return alive[(int)side].size();
+}
+
+Entity CharacterIndex::lowest_health(Side side)
+{
+	refresh_health();
+	return lowest[(int)side];
+}
+
+size_t CharacterIndex::below_half_health(Side side)
+{
+	refresh_health();
+	return below_half[(int)side];
+}
+
+Entity CharacterIndex::front_most(Side side)
+{
+	// Positions change every step without marking the motions as changed, so this one is a scan over the side
+	refresh();
+	Entity best;
+	float best_x = 0.f;
+	for (Entity e : alive[(int)side])
+	{
+		if (!motions.has(e))
+			continue;
+		float x = motions.get(e).position.x;
+		// Companions advance to the right, enemies to the left
+		if (side == Side::ENEMY)
+			x = -x;
+		if (best == Entity() || x > best_x)
+		{
+			best = e;
+			best_x = x;
+		}
+	}
+	return best;
+}
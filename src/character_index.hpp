@@ -0,0 +1,76 @@
+#pragma once
+
+#include <vector>
+
+#include "tiny_ecs.hpp"
+#include "components.hpp"
+
+// The two sides of a battle, companions fight for the player
+enum class Side {
+	PLAYER = 0,
+	ENEMY = 1,
+};
+
+// Lookup of the companions and enemies by side and CharacterType, plus per-side aggregates
+// The lists are rebuilt lazily when the companion, enemy or death timer containers change structure (see
+// ComponentContainer::structure_version) and the health aggregates when the statistics change (see current_tick),
+// so queries between such changes are plain table reads. Entities keep the order of their container.
+class CharacterIndex
+{
+public:
+	CharacterIndex(ComponentContainer<Companion>& companions, ComponentContainer<Enemy>& enemies,
+		ComponentContainer<Statistics>& stats, ComponentContainer<Motion>& motions, ComponentContainer<DeathTimer>& deathTimers);
+
+	// The characters of 'side' with the given CharacterType
+	const std::vector<Entity>& of(Side side, int type);
+
+	// Check if 'side' has a character of the given type
+	bool any(Side side, int type);
+
+	// Sets 'found' to the last character of the given type, the one a scan over the container would end on,
+	// and leaves it unchanged if there is none
+	bool find_last(Side side, int type, Entity& found);
+
+	// CharacterType of a companion or enemy, 0 for any other entity
+	int type_of(Entity e);
+
+	// Number of characters of 'side' that are not dying (have no DeathTimer)
+	size_t alive_count(Side side);
+
+	// The first character of 'side' with the lowest health, the null entity if the side is empty
+	Entity lowest_health(Side side);
+
+	// Number of characters of 'side' below half of their maximum health
+	size_t below_half_health(Side side);
+
+	// The character of 'side' that is not dying and stands furthest towards the other side (companions stand
+	// on the left), the null entity if there is none
+	Entity front_most(Side side);
+
+private:
+	static const int type_count = DRAGON + 1;
+	static const std::vector<Entity> none;
+
+	ComponentContainer<Companion>& companions;
+	ComponentContainer<Enemy>& enemies;
+	ComponentContainer<Statistics>& stats;
+	ComponentContainer<Motion>& motions;
+	ComponentContainer<DeathTimer>& deathTimers;
+
+	// Structure versions of companions, enemies and deathTimers at the last rebuild
+	unsigned int versions[3] = { ~0u, ~0u, ~0u };
+	std::vector<Entity> by_type[2][type_count];
+	std::vector<Entity> members[2];
+	std::vector<Entity> alive[2];
+	// Entity and CharacterType by entity index, the entity tells stale handles apart
+	std::vector<std::pair<Entity, int>> types;
+
+	// Statistics tick and structure version at the last health update
+	unsigned int health_tick = ~0u, health_version = ~0u;
+	Entity lowest[2];
+	size_t below_half[2] = { 0, 0 };
+
+	void refresh();
+	void refresh_health();
+	void add(Side side, Entity e, int type);
+};
@@ -0,0 +1,177 @@
+// internal
+#include "collision_mesh.hpp"
+
+// stlib
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+// Cache file layout: magic, version, vertex cap, hash of the source vertices, corner count, corners as x y floats
+static const char cache_magic[4] = { 'C', 'M', 'S', 'H' };
+static const uint32_t cache_version = 1;
+
+// FNV-1a over the x-y positions the shape is built from
+static uint64_t hash_vertices(const std::vector<ColoredVertex>& vertices)
+{
+	uint64_t hash = 14695981039346656037ull;
+	auto add = [&hash](const void* data, size_t size) {
+		const unsigned char* bytes = (const unsigned char*)data;
+		for (size_t i = 0; i < size; i++)
+		{
+			hash ^= bytes[i];
+			hash *= 1099511628211ull;
+		}
+	};
+	uint64_t count = vertices.size();
+	add(&count, sizeof(count));
+	for (const ColoredVertex& vertex : vertices)
+	{
+		add(&vertex.position.x, sizeof(float));
+		add(&vertex.position.y, sizeof(float));
+	}
+	return hash;
+}
+
+static float cross(vec2 o, vec2 a, vec2 b)
+{
+	return (a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x);
+}
+
+// Counter-clockwise convex hull (monotone chain), collinear points are dropped
+static std::vector<vec2> convex_hull(std::vector<vec2> points)
+{
+	std::sort(points.begin(), points.end(), [](vec2 a, vec2 b) { return a.x < b.x || (a.x == b.x && a.y < b.y); });
+	points.erase(std::unique(points.begin(), points.end()), points.end());
+	if (points.size() < 3)
+		return points;
+
+	std::vector<vec2> hull(2 * points.size());
+	size_t k = 0;
+	// Lower half, then upper half
+	for (size_t i = 0; i < points.size(); i++)
+	{
+		while (k >= 2 && cross(hull[k - 2], hull[k - 1], points[i]) <= 0.f)
+			k--;
+		hull[k++] = points[i];
+	}
+	for (size_t i = points.size() - 1, lower = k + 1; i > 0; i--)
+	{
+		while (k >= lower && cross(hull[k - 2], hull[k - 1], points[i - 1]) <= 0.f)
+			k--;
+		hull[k++] = points[i - 1];
+	}
+	hull.resize(k - 1); // the last point is the first one again
+	return hull;
+}
+
+// Drop the corner that spans the smallest triangle with its neighbours until at most max_vertices are left
+// The hull stays convex and only shrinks by the smallest slivers, so the shape keeps to the outline
+static void simplify_hull(std::vector<vec2>& hull, size_t max_vertices)
+{
+	max_vertices = std::max(max_vertices, (size_t)3);
+	while (hull.size() > max_vertices)
+	{
+		size_t n = hull.size();
+		size_t smallest = 0;
+		float smallest_area = INFINITY;
+		for (size_t i = 0; i < n; i++)
+		{
+			float area = std::abs(cross(hull[(i + n - 1) % n], hull[i], hull[(i + 1) % n]));
+			if (area < smallest_area)
+			{
+				smallest = i;
+				smallest_area = area;
+			}
+		}
+		hull.erase(hull.begin() + smallest);
+	}
+}
+
+static bool read_cache(const std::string& path, uint64_t hash, uint32_t max_vertices, std::vector<vec2>& corners)
+{
+	FILE* file = fopen(path.c_str(), "rb");
+	if (file == NULL)
+		return false;
+
+	char magic[4];
+	uint32_t version = 0, cap = 0, count = 0;
+	uint64_t source_hash = 0;
+	bool valid = fread(magic, sizeof(magic), 1, file) == 1 && std::equal(magic, magic + 4, cache_magic)
+		&& fread(&version, sizeof(version), 1, file) == 1 && version == cache_version
+		&& fread(&cap, sizeof(cap), 1, file) == 1 && cap == max_vertices
+		&& fread(&source_hash, sizeof(source_hash), 1, file) == 1 && source_hash == hash
+		&& fread(&count, sizeof(count), 1, file) == 1 && count <= max_vertices;
+	if (valid)
+	{
+		corners.resize(count);
+		valid = count == 0 || fread(corners.data(), sizeof(vec2), count, file) == count;
+	}
+	fclose(file);
+	return valid;
+}
+
+// Returns false if the file could not be written, a partly written one is removed again
+static bool write_cache(const std::string& path, uint64_t hash, uint32_t max_vertices, const std::vector<vec2>& corners)
+{
+	FILE* file = fopen(path.c_str(), "wb");
+	if (file == NULL)
+		return false;
+	uint32_t count = (uint32_t)corners.size();
+	bool written = fwrite(cache_magic, sizeof(cache_magic), 1, file) == 1
+		&& fwrite(&cache_version, sizeof(cache_version), 1, file) == 1
+		&& fwrite(&max_vertices, sizeof(max_vertices), 1, file) == 1
+		&& fwrite(&hash, sizeof(hash), 1, file) == 1
+		&& fwrite(&count, sizeof(count), 1, file) == 1
+		&& (count == 0 || fwrite(corners.data(), sizeof(vec2), count, file) == count);
+	written = fclose(file) == 0 && written;
+	if (!written)
+		remove(path.c_str());
+	return written;
+}
+
+std::string collisionMeshCachePath(const std::string& mesh_path)
+{
+	size_t name_start = mesh_path.find_last_of("/\\");
+	std::string name = name_start == std::string::npos ? mesh_path : mesh_path.substr(name_start + 1);
+	return cache_path(name + ".collision");
+}
+
+bool buildCollisionMesh(const Mesh& mesh, Mesh& out, const std::string& cache_path, size_t max_vertices)
+{
+	// disable warnings about fopen on Windows
+#ifdef _MSC_VER
+	#pragma warning(disable:4996)
+#endif
+
+	uint32_t cap = (uint32_t)std::min(std::max(max_vertices, (size_t)3), (size_t)UINT16_MAX);
+	uint64_t hash = hash_vertices(mesh.vertices);
+
+	std::vector<vec2> corners;
+	if (!read_cache(cache_path, hash, cap, corners))
+	{
+		std::vector<vec2> points;
+		points.reserve(mesh.vertices.size());
+		for (const ColoredVertex& vertex : mesh.vertices)
+			points.push_back({ vertex.position.x, vertex.position.y });
+		corners = convex_hull(std::move(points));
+		simplify_hull(corners, cap);
+		// The shape is built in memory either way, it is only rebuilt on the next start
+		if (!write_cache(cache_path, hash, cap, corners))
+			printf("Could not write the collision mesh cache %s\n", cache_path.c_str());
+	}
+
+	out.original_size = mesh.original_size;
+	out.vertices.clear();
+	out.vertex_indices.clear();
+	for (vec2 corner : corners)
+		out.vertices.push_back({ { corner.x, corner.y, 0.f }, { 0.f, 0.f, 0.f } });
+	// Fan from the first corner, the hull is convex
+	for (size_t i = 1; i + 1 < corners.size(); i++)
+	{
+		out.vertex_indices.push_back(0);
+		out.vertex_indices.push_back((uint16_t)i);
+		out.vertex_indices.push_back((uint16_t)(i + 1));
+	}
+	return !out.vertex_indices.empty();
+}
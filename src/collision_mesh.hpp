@@ -0,0 +1,19 @@
+#pragma once
+
+#include <string>
+
+#include "common.hpp"
+#include "components.hpp"
+
+// Vertex cap of the generated collision meshes, so a narrow phase test costs at most (cap - 2)^2 triangle pairs
+const size_t collision_mesh_max_vertices = 16;
+
+// Fill 'out' with the collision shape of a render mesh: the convex hull of its x-y outline, cut down to at most
+// 'max_vertices' corners and fanned into triangles, in the same normalized space as the render mesh
+// The shape is read from 'cache_path' when it was built from the same vertices with the same cap, otherwise it is
+// built and written there for the next start. Returns false if the mesh has no area to give a shape.
+bool buildCollisionMesh(const Mesh& mesh, Mesh& out, const std::string& cache_path,
+	size_t max_vertices = collision_mesh_max_vertices);
+
+// Path of the collision mesh cache of the OBJ file 'mesh_path' in the cache directory, which is created if needed
+std::string collisionMeshCachePath(const std::string& mesh_path);
@@ -0,0 +1,44 @@
+// internal
+#include "command_buffer.hpp"
+
+#include <algorithm>
+
+void CommandBuffer::flush()
+{
+	if (!recorded)
+		return;
+	recorded = false;
+
+	// Entities attached to a destroyed one go with it, the list grows while it is walked
+	for (size_t i = 0; i < destroys.size(); i++)
+		registry.children_of(destroys[i], destroys);
+
+	// Destroyed entities are removed from every container named in their signature, together with the
+	// single component removes. Sorting makes the batch independent of the recording order.
+	std::sort(destroys.begin(), destroys.end(), [](Entity a, Entity b) { return a.index() < b.index(); });
+	destroys.erase(std::unique(destroys.begin(), destroys.end(), [](Entity a, Entity b) { return (unsigned int)a == (unsigned int)b; }), destroys.end());
+	for (Entity e : destroys)
+	{
+		Signature s = registry.signature(e);
+		for (unsigned int id = 0; s.any() && id < removes.size(); id++)
+			if (s.test(id)) {
+				removes[id].push_back(e);
+				s.reset(id);
+			}
+	}
+
+	// One compaction per container
+	for (unsigned int id = 0; id < removes.size(); id++)
+		if (!removes[id].empty()) {
+			registry.container(id).remove_batch(removes[id]);
+			removes[id].clear();
+		}
+
+	for (Entity e : destroys)
+		registry.release(e);
+	destroys.clear();
+
+	for (std::unique_ptr<PendingInserts>& pending : inserts)
+		if (pending)
+			pending->flush();
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include "tiny_ecs_registry.hpp"
+
+// Records structural changes (new components, removed components, destroyed entities) during a system pass
+// and applies them in one batch at a sync point (flush). Systems can then iterate the containers forwards
+// while deciding what to add or remove, without the containers being re-ordered underneath them.
+// On flush, removes and destroys are grouped per container and compacted together, then the inserts of every
+// container are appended after a single reserve. Inserts for entities that were destroyed are dropped.
+class CommandBuffer
+{
+	// Inserts of one component type, in the order they were recorded
+	struct PendingInserts
+	{
+		virtual ~PendingInserts() {}
+		virtual void flush() = 0;
+	};
+	template <typename Component>
+	struct TypedInserts : PendingInserts
+	{
+		std::vector<Entity> entities;
+		std::vector<Component> components;
+
+		void flush() override
+		{
+			ComponentContainer<Component>& container = registry.pool<Component>();
+			container.reserve(container.size() + components.size());
+			for (size_t i = 0; i < components.size(); i++)
+				if (registry.valid(entities[i]))
+					container.insert(entities[i], std::move(components[i]));
+			entities.clear();
+			components.clear();
+		}
+	};
+
+	// Indexed by component id
+	std::vector<std::unique_ptr<PendingInserts>> inserts;
+	std::vector<std::vector<Entity>> removes;
+	std::vector<Entity> destroys;
+	bool recorded = false;
+
+	template <typename Component>
+	TypedInserts<Component>& inserts_of()
+	{
+		std::unique_ptr<PendingInserts>& slot = inserts[ECSRegistry::component_id<Component>()];
+		if (!slot)
+			slot.reset(new TypedInserts<Component>());
+		return static_cast<TypedInserts<Component>&>(*slot);
+	}
+
+public:
+	CommandBuffer() : inserts(ECSRegistry::component_count()), removes(ECSRegistry::component_count())
+	{
+	}
+
+	// Entity handles are handed out right away, the entity has no components until the next flush
+	Entity create()
+	{
+		return registry.create();
+	}
+
+	// Add component c to entity e on the next flush
+	template <typename Component>
+	void insert(Entity e, Component c)
+	{
+		TypedInserts<Component>& pending = inserts_of<Component>();
+		pending.entities.push_back(e);
+		pending.components.push_back(std::move(c));
+		recorded = true;
+	}
+	template <typename Component, typename... Args>
+	void emplace(Entity e, Args &&... args)
+	{
+		insert(e, Component(std::forward<Args>(args)...));
+	}
+
+	// Remove the 'Component' of entity e on the next flush
+	template <typename Component>
+	void remove(Entity e)
+	{
+		removes[ECSRegistry::component_id<Component>()].push_back(e);
+		recorded = true;
+	}
+
+	// Destroy entity e on the next flush, see ECSRegistry::destroy
+	void destroy(Entity e)
+	{
+		destroys.push_back(e);
+		recorded = true;
+	}
+
+	bool empty() const { return !recorded; }
+
+	// Apply all recorded changes to the registry: removes and destroys first, then inserts
+	void flush();
+};
@@ -1,5 +1,23 @@
 #include "common.hpp"
 
+#ifdef _WIN32
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#endif
+
+std::string cache_path(const std::string& name)
+{
+	static const std::string cache_directory = "./cache";
+	// The directory may already exist, a failure shows up when the file is written
+#ifdef _WIN32
+	_mkdir(cache_directory.c_str());
+#else
+	mkdir(cache_directory.c_str(), 0755);
+#endif
+	return cache_directory + "/" + name;
+}
+
 // Note, we could also use the functions from GLM but we write the transformations here to show the uderlying math
 void Transform::scale(vec2 scale)
 {
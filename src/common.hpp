@@ -29,6 +29,8 @@ inline std::string shader_path(const std::string& name) {return std::string(PROJ
 inline std::string textures_path(const std::string& name) {return data_path() + "/textures/" + std::string(name);};
 inline std::string audio_path(const std::string& name) {return data_path() + "/audio/" + std::string(name);};
 inline std::string mesh_path(const std::string& name) {return data_path() + "/meshes/" + std::string(name);};
+// cache_path("file") -> ./cache/file, next to the save file in the working directory, which is created if needed
+std::string cache_path(const std::string& name);
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846f
@@ -87,4 +89,7 @@ extern int16 loadedLevel;
 
 // Free roam variables
 extern bool isFreeRoam;
-extern int freeRoamLevel;
\ No newline at end of file
+extern int freeRoamLevel;
+
+// Collision grid cell size of the current level, 0 for automatic
+extern float collisionCellSize;
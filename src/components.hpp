@@ -281,12 +281,64 @@ struct PreciseCollider
 
 };
 
+// Collision layers, an entity can be on several
+enum CollisionLayer {
+	LAYER_CHARACTER = 1 << 0,
+	LAYER_PROJECTILE = 1 << 1,
+	LAYER_PLATFORM = 1 << 2,
+	LAYER_CHEST = 1 << 3,
+	LAYER_FIREFLY = 1 << 4,
+	LAYER_BOULDER = 1 << 5,
+	LAYER_OBSTACLE = 1 << 6, // deformable background objects and barriers
+};
+
+// Only entities with a Collider are tested for collisions, and a pair only if each one's category is in the
+// other's mask (see addCollider for the usual masks)
+struct Collider
+{
+	unsigned int category = 0;
+	unsigned int mask = 0;
+};
+
+// Collision box of a collider relative to its Motion, as given by PhysicsSystem::get_custom_position and
+// get_custom_bounding_box. Cached by PhysicsSystem::update_shapes, which recomputes it when motion.scale changes.
+struct CollisionShape
+{
+	vec2 offset = { 0.f, 0.f };
+	vec2 half_extents = { 0.f, 0.f };
+	vec2 scale = { 0.f, 0.f }; // the motion.scale it was computed for
+};
+
+// Keeps the entity's Motion at 'offset' from the position of 'parent' (see PhysicsSystem::resolve_attachments),
+// and destroying the parent destroys the entity too. Set with attach in world_init.hpp, which keeps the registry's
+// index of children up to date, so 'parent' must not be changed in place.
+struct Attachment
+{
+	Entity parent;
+	vec2 offset = { 0.f, 0.f };
+};
+
+// How the physics system moves a Motion (see PhysicsSystem::update_sleep)
+enum class BodyType
+{
+	STATIC,    // not integrated, only seen by the collision tests
+	KINEMATIC, // moved by game code, integrated every step and never put to sleep
+	DYNAMIC    // integrated, and put to sleep after resting for a while
+};
+
+// Body type of an entity, a Motion without one is dynamic, or kinematic if it has an Attachment
+struct RigidBody
+{
+	BodyType type = BodyType::DYNAMIC;
+};
+
 struct StatIndicator
 {
 	Entity owner;
 };
 
 // All data relevant to the shape and motion of entities
+// Modify it through registry.motions.get_mut (or patch), which also wakes the body if the physics put it to sleep
 struct Motion {
 	vec2 position = { 0, 0 };
 	float angle = 0;
@@ -295,12 +347,21 @@ struct Motion {
 	vec2 acceleration = { 0, 0 };
 };
 
-// Stucture to store collision information
-struct Collision
+// Stages of a contact between two colliders, reported once per pair and step (see ContactCache)
+enum class ContactPhase
 {
-	// Note, the first object is stored in the ECS container.entities
-	Entity other; // the second object involved in the collision
-	Collision(Entity& other) { this->other = other; };
+	BEGIN, // the pair started touching this step
+	STAY,  // the pair was touching in the last step and still is
+	END    // the pair stopped touching, or one of them is gone
+};
+
+// Contact event between two colliders, 'a' has the lower entity id
+struct Contact
+{
+	Entity a;
+	Entity b;
+	ContactPhase phase;
+	float time_of_impact; // fraction of the step at which a swept projectile first touched, 1 for overlaps at the end
 };
 
 struct HoverBox 
@@ -312,6 +373,8 @@ struct HoverBox
 struct Debug {
 	bool in_debug_mode = 0;
 	bool in_freeze_mode = 0;
+	// Set by the T key, the main loop then writes the recent ECS telemetry samples
+	bool dump_telemetry = 0;
 };
 extern Debug debugging;
 
@@ -804,11 +867,7 @@ enum class GEOMETRY_BUFFER_ID {
 	TREASURE_CHEST_CLOSED = ARROW_MESH + 1,
 	TREASURE_CHEST_OPEN = TREASURE_CHEST_CLOSED + 1,
 
-	// SIMPLIFIED MESHES
-	SIMPLIFIED_ROCK_MESH = TREASURE_CHEST_OPEN + 1,
-	SIMPLIFIED_ARROW_MESH = SIMPLIFIED_ROCK_MESH + 1,
-
-	GEOMETRY_COUNT = SIMPLIFIED_ARROW_MESH + 1
+	GEOMETRY_COUNT = TREASURE_CHEST_OPEN + 1
 };
 const int geometry_count = (int)GEOMETRY_BUFFER_ID::GEOMETRY_COUNT;
 
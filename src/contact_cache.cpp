@@ -0,0 +1,50 @@
+// internal
+#include "contact_cache.hpp"
+
+// stlib
+#include <algorithm>
+
+void ContactCache::begin_step()
+{
+	std::swap(current, previous);
+	current.clear();
+}
+
+void ContactCache::touch(Entity a, Entity b, float time_of_impact)
+{
+	if ((unsigned int)b < (unsigned int)a)
+		std::swap(a, b);
+	current.push_back({ ((unsigned long long)(unsigned int)a << 32) | (unsigned int)b, a, b, time_of_impact });
+}
+
+void ContactCache::end_step(std::vector<Contact>& events)
+{
+	// Keep the earliest impact of a pair reported more than once
+	std::sort(current.begin(), current.end(), [](const Pair& x, const Pair& y) {
+		return x.key < y.key || (x.key == y.key && x.time_of_impact < y.time_of_impact);
+	});
+	current.erase(std::unique(current.begin(), current.end(), [](const Pair& x, const Pair& y) { return x.key == y.key; }),
+		current.end());
+
+	// Both lists are sorted, walk them side by side
+	size_t i = 0, j = 0;
+	while (i < current.size() || j < previous.size())
+	{
+		if (j == previous.size() || (i < current.size() && current[i].key < previous[j].key))
+		{
+			events.push_back(Contact{ current[i].a, current[i].b, ContactPhase::BEGIN, current[i].time_of_impact });
+			i++;
+		}
+		else if (i == current.size() || previous[j].key < current[i].key)
+		{
+			events.push_back(Contact{ previous[j].a, previous[j].b, ContactPhase::END, 1.f });
+			j++;
+		}
+		else
+		{
+			events.push_back(Contact{ current[i].a, current[i].b, ContactPhase::STAY, current[i].time_of_impact });
+			i++;
+			j++;
+		}
+	}
+}
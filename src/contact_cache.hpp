@@ -0,0 +1,44 @@
+#pragma once
+
+#include <vector>
+
+#include "common.hpp"
+#include "tiny_ecs.hpp"
+#include "components.hpp"
+
+// Remembers which pairs of colliders touch from one step to the next and turns that into Contact events
+// Pairs are identified by (lower id, higher id), so the order in which a pair is reported does not matter and
+// reporting it twice in a step is harmless. The pair lists are sorted vectors that keep their memory, so a
+// step allocates nothing once they have grown to the number of contacts.
+class ContactCache
+{
+public:
+	// Start collecting the pairs touching in this step
+	void begin_step();
+
+	// Record that a and b touch in this step
+	void touch(Entity a, Entity b, float time_of_impact = 1.f);
+
+	// Record again the pairs of the last step for which keep(a, b) holds, for pairs that were not tested
+	template <typename Keep>
+	void carry_over(Keep keep)
+	{
+		for (const Pair& pair : previous)
+			if (keep(pair.a, pair.b))
+				current.push_back({ pair.key, pair.a, pair.b, 1.f });
+	}
+
+	// Compare the pairs of this step with the last one and append one event per pair to 'events', sorted by pair
+	void end_step(std::vector<Contact>& events);
+
+private:
+	struct Pair
+	{
+		unsigned long long key;
+		Entity a, b;
+		float time_of_impact;
+	};
+
+	std::vector<Pair> current;
+	std::vector<Pair> previous;
+};
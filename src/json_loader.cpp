@@ -165,6 +165,14 @@ void load_level(json j){
         printf("Loading swordsman hp buff\n");
         registry.swordsmanHPBuff = j["swordsmanHPBuff"];
     }
+    if(!j["capacity"].is_null()){
+        printf("Reserving component capacity\n");
+        registry.reserve(j["capacity"].get<ECSRegistry::CapacityProfile>());
+    }
+    if(!j["collisionCellSize"].is_null()){
+        printf("Loading collision cell size\n");
+        collisionCellSize = j["collisionCellSize"];
+    }
 
     if(!j["level"].is_null()){
         printf("Loading level\n");
@@ -330,7 +338,7 @@ void load_level(json j){
                                                                 
             } else if(component["type"] == "stat"){
                 printf("Emplacing entity in stats\n");
-                Statistics& stat = registry.stats.get(create_entity);
+                Statistics& stat = registry.stats.get_mut(create_entity);
                 stat.health = component["health"];
                 stat.speed = component["speed"];
             } else if(component["type"] == "silenced"){
@@ -602,4 +610,39 @@ bool JSONLoader::get_save_file(){
         printf("File not found\n");
         return false;
     }
-}
\ No newline at end of file
+}
+
+// Reads the capacity profile recorded for a level by save_capacity_profile, empty if there is none
+ECSRegistry::CapacityProfile JSONLoader::get_capacity_profile(string level){
+    std::ifstream profile_file(cache_path("capacity_profiles.json"));
+    if (!profile_file.is_open()){
+        return ECSRegistry::CapacityProfile();
+    }
+    json j = json::parse(profile_file, nullptr, false);
+    if (j.is_discarded() || j[level].is_null()){
+        return ECSRegistry::CapacityProfile();
+    }
+    return j[level].get<ECSRegistry::CapacityProfile>();
+}
+
+// Records the capacity profile of a level, the profiles of the other levels are kept
+// The file is only written when the profile of the level differs from the recorded one
+void JSONLoader::save_capacity_profile(string level, const ECSRegistry::CapacityProfile& profile){
+    string path = cache_path("capacity_profiles.json");
+    json j = json::object();
+    std::ifstream profile_file(path);
+    if (profile_file.is_open()){
+        j = json::parse(profile_file, nullptr, false);
+        profile_file.close();
+        if (j.is_discarded() || !j.is_object()){
+            j = json::object();
+        }
+    }
+    json level_profile = profile;
+    if (j.contains(level) && j[level] == level_profile){
+        return;
+    }
+    j[level] = level_profile;
+    ofstream save_file(path);
+    save_file << j;
+}
@@ -4,6 +4,7 @@
 #include "common.hpp"
 #include "render_system.hpp"
 #include "tiny_ecs.hpp"
+#include "tiny_ecs_registry.hpp"
 
 using namespace std;
 
@@ -14,5 +15,7 @@ class JSONLoader
         void get_level(std::string file_name);
         bool get_save_file();
         void save_game();
+        ECSRegistry::CapacityProfile get_capacity_profile(std::string level);
+        void save_capacity_profile(std::string level, const ECSRegistry::CapacityProfile& profile);
         void init(RenderSystem* renderer);
 };
\ No newline at end of file
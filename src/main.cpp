@@ -11,6 +11,9 @@
 // stlib
 #include <chrono>
 #include <iostream>
+#include <fstream>
+#include <cmath>
+#include <deque>
 
 
 // internal
@@ -28,6 +31,27 @@ using namespace std;
 int window_width_px = 1200;
 int window_height_px = 750;
 
+// Rate of the fixed simulation tick, 60 or 120 Hz
+#ifndef SIMULATION_HZ
+#define SIMULATION_HZ 60
+#endif
+const float SIMULATION_STEP_MS = 1000.f / SIMULATION_HZ;
+// Ticks a frame may run to catch up after a hitch, the simulation slows down beyond that
+const int MAX_CATCH_UP_STEPS = 5;
+
+// With ECS_TELEMETRY, the telemetry is sampled every few frames into a ring of the most recent samples, which is
+// written on the T key and on exit. Without it, the T key writes a single sample of the current pools.
+#if ECS_TELEMETRY
+const int TELEMETRY_SAMPLE_FRAMES = 30;
+const size_t TELEMETRY_SAMPLES = 120;
+#endif
+
+void writeTelemetry(const std::deque<std::string>& samples) {
+	std::ofstream telemetry_log("ecs_telemetry.jsonl");
+	for (const std::string& sample : samples)
+		telemetry_log << sample << '\n';
+}
+
 // Get the horizontal and vertical screen sizes in pixel
 void getScreenResolution(unsigned int& width, unsigned int& height) {
 #if WIN32
@@ -68,11 +92,17 @@ int main()
 	renderer.init(window_width_px, window_height_px, window);
 	world.init(&renderer, &ai, &sk, &swarmSys);
 	
-	// variable timestep loop
+	// fixed timestep loop, rendering interpolates between the last two ticks
 	auto t = Clock::now();
+	float accumulator_ms = 0.f;
 	
 	isFreeRoam = 0;
 
+	std::deque<std::string> telemetry_samples;
+#if ECS_TELEMETRY
+	int frame = 0;
+#endif
+
 	while (!world.is_over()) {
 		// Processes system messages, if this wasn't present the window would become
 		// unresponsive
@@ -84,20 +114,53 @@ int main()
 			(float)(std::chrono::duration_cast<std::chrono::microseconds>(now - t)).count() / 1000;
 		t = now;
 
-		if (world.canStep) {
-			world.step(elapsed_ms);
-			// ai.step(elapsed_ms);
-			if(isFreeRoam){
-				physics.step_freeRoam(elapsed_ms, window_width_px, window_height_px);
-			} else {
-				physics.step(elapsed_ms, window_width_px, window_height_px);
+		accumulator_ms += elapsed_ms;
+		int steps = 0;
+		while (accumulator_ms >= SIMULATION_STEP_MS && steps < MAX_CATCH_UP_STEPS) {
+			if (world.canStep) {
+				renderer.save_previous_motions();
+				world.step(SIMULATION_STEP_MS);
+				// ai.step(SIMULATION_STEP_MS);
+				if(isFreeRoam){
+					physics.step_freeRoam(SIMULATION_STEP_MS, window_width_px, window_height_px);
+				} else {
+					physics.step(SIMULATION_STEP_MS, window_width_px, window_height_px);
+				}
+				world.handle_collisions();
+				world.handle_boundary_collision();
 			}
-			world.handle_collisions();
-			world.handle_boundary_collision();
+			accumulator_ms -= SIMULATION_STEP_MS;
+			steps++;
 		}
+		// Drop the time that could not be caught up instead of spiralling
+		if (accumulator_ms >= SIMULATION_STEP_MS)
+			accumulator_ms = fmod(accumulator_ms, SIMULATION_STEP_MS);
 
+		renderer.set_interpolation(world.canStep ? accumulator_ms / SIMULATION_STEP_MS : 1.f);
 		renderer.draw(elapsed_ms);
+
+#if ECS_TELEMETRY
+		// The counters of a sample cover the frame it was taken in
+		if (frame++ % TELEMETRY_SAMPLE_FRAMES == 0) {
+			if (telemetry_samples.size() == TELEMETRY_SAMPLES)
+				telemetry_samples.pop_front();
+			telemetry_samples.push_back(registry.telemetry_json());
+		}
+#endif
+		if (debugging.dump_telemetry) {
+#if !ECS_TELEMETRY
+			telemetry_samples.assign(1, registry.telemetry_json());
+#endif
+			writeTelemetry(telemetry_samples);
+			debugging.dump_telemetry = false;
+		}
+#if ECS_TELEMETRY
+		registry.reset_telemetry_counters();
+#endif
 	}
+#if ECS_TELEMETRY
+	writeTelemetry(telemetry_samples);
+#endif
 
 	return EXIT_SUCCESS;
 }
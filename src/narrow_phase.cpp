@@ -0,0 +1,132 @@
+// internal
+#include "narrow_phase.hpp"
+#include "tiny_ecs_registry.hpp"
+
+// stlib
+#include <algorithm>
+
+constexpr float NarrowPhase::epsilon;
+
+void NarrowPhase::begin_step()
+{
+	used = 0;
+	slot_of.clear();
+}
+
+size_t NarrowPhase::world_mesh(Entity e)
+{
+	auto it = slot_of.find(e);
+	if (it != slot_of.end())
+		return it->second;
+
+	// Slots are re-used from step to step so that their vertex arrays keep their memory
+	if (used == meshes.size())
+		meshes.emplace_back();
+	size_t slot = used++;
+	WorldMesh& world = meshes[slot];
+	slot_of[e] = slot;
+
+	const Motion& motion = registry.motions.get(e);
+	const Mesh* mesh = registry.meshPtrs.get(e);
+	Transform transform;
+	transform.translate(motion.position);
+	transform.rotate(motion.angle);
+	transform.scale(motion.scale);
+
+	world.indices = &mesh->vertex_indices;
+	world.vertices.resize(mesh->vertices.size());
+	world.min = vec2(INFINITY);
+	world.max = vec2(-INFINITY);
+	for (size_t i = 0; i < mesh->vertices.size(); i++)
+	{
+		vec3 p = transform.mat * vec3(mesh->vertices[i].position.x, mesh->vertices[i].position.y, 1.f);
+		world.vertices[i] = { p.x, p.y };
+		world.min = glm::min(world.min, world.vertices[i]);
+		world.max = glm::max(world.max, world.vertices[i]);
+	}
+	return slot;
+}
+
+static bool boxes_overlap(vec2 min_a, vec2 max_a, vec2 min_b, vec2 max_b, float epsilon)
+{
+	return min_a.x <= max_b.x + epsilon && min_b.x <= max_a.x + epsilon
+		&& min_a.y <= max_b.y + epsilon && min_b.y <= max_a.y + epsilon;
+}
+
+// Collect the triangles of 'mesh' whose bounding box reaches into [min, max]
+static void triangles_in_box(const WorldMesh& mesh, vec2 min, vec2 max, float epsilon, std::vector<unsigned int>& out)
+{
+	out.clear();
+	const std::vector<uint16_t>& indices = *mesh.indices;
+	for (unsigned int i = 0; i + 2 < indices.size(); i += 3)
+	{
+		vec2 p0 = mesh.vertices[indices[i]], p1 = mesh.vertices[indices[i + 1]], p2 = mesh.vertices[indices[i + 2]];
+		vec2 tri_min = glm::min(p0, glm::min(p1, p2));
+		vec2 tri_max = glm::max(p0, glm::max(p1, p2));
+		if (boxes_overlap(tri_min, tri_max, min, max, epsilon))
+			out.push_back(i);
+	}
+}
+
+// Check if the projections of the two triangles on 'axis' are separated by more than epsilon
+static bool separated_on(vec2 axis, const vec2* a, const vec2* b, float epsilon)
+{
+	float length_squared = dot(axis, axis);
+	if (length_squared == 0.f)
+		return false; // degenerate edge, gives no axis
+	axis /= sqrt(length_squared);
+	float min_a = dot(axis, a[0]), max_a = min_a;
+	float min_b = dot(axis, b[0]), max_b = min_b;
+	for (int k = 1; k < 3; k++)
+	{
+		float pa = dot(axis, a[k]), pb = dot(axis, b[k]);
+		min_a = std::min(min_a, pa);
+		max_a = std::max(max_a, pa);
+		min_b = std::min(min_b, pb);
+		max_b = std::max(max_b, pb);
+	}
+	return max_a < min_b - epsilon || max_b < min_a - epsilon;
+}
+
+// Two triangles overlap unless one of their edge normals separates them
+static bool triangles_overlap(const vec2* a, const vec2* b, float epsilon)
+{
+	for (int k = 0; k < 3; k++)
+	{
+		vec2 edge_a = a[(k + 1) % 3] - a[k];
+		vec2 edge_b = b[(k + 1) % 3] - b[k];
+		if (separated_on({ -edge_a.y, edge_a.x }, a, b, epsilon) || separated_on({ -edge_b.y, edge_b.x }, a, b, epsilon))
+			return false;
+	}
+	return true;
+}
+
+bool NarrowPhase::overlaps(Entity a, Entity b)
+{
+	// Both slots first, adding the second may move the first
+	size_t slot_a = world_mesh(a);
+	size_t slot_b = world_mesh(b);
+	const WorldMesh& mesh_a = meshes[slot_a];
+	const WorldMesh& mesh_b = meshes[slot_b];
+	if (!boxes_overlap(mesh_a.min, mesh_a.max, mesh_b.min, mesh_b.max, epsilon))
+		return false;
+
+	triangles_in_box(mesh_a, mesh_b.min, mesh_b.max, epsilon, candidates_a);
+	if (candidates_a.empty())
+		return false;
+	triangles_in_box(mesh_b, mesh_a.min, mesh_a.max, epsilon, candidates_b);
+
+	const std::vector<uint16_t>& indices_a = *mesh_a.indices;
+	const std::vector<uint16_t>& indices_b = *mesh_b.indices;
+	for (unsigned int i : candidates_a)
+	{
+		vec2 tri_a[3] = { mesh_a.vertices[indices_a[i]], mesh_a.vertices[indices_a[i + 1]], mesh_a.vertices[indices_a[i + 2]] };
+		for (unsigned int j : candidates_b)
+		{
+			vec2 tri_b[3] = { mesh_b.vertices[indices_b[j]], mesh_b.vertices[indices_b[j + 1]], mesh_b.vertices[indices_b[j + 2]] };
+			if (triangles_overlap(tri_a, tri_b, epsilon))
+				return true;
+		}
+	}
+	return false;
+}
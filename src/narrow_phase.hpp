@@ -0,0 +1,44 @@
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+
+#include "common.hpp"
+#include "tiny_ecs.hpp"
+#include "components.hpp"
+
+// A mesh transformed by its entity's Motion, with its bounding box
+struct WorldMesh
+{
+	std::vector<vec2> vertices;
+	const std::vector<uint16_t>* indices = nullptr;
+	vec2 min = { 0.f, 0.f };
+	vec2 max = { 0.f, 0.f };
+};
+
+// Exact overlap test between the triangle meshes of two PreciseCollider entities
+// Each mesh is transformed into world space once per step, on first use. A pair is rejected by the bounding boxes
+// first, then only the triangles that reach into the other mesh's box are tested against each other with the
+// separating axis theorem, where touching within 'epsilon' counts as overlapping.
+class NarrowPhase
+{
+public:
+	// Forget the world meshes of the last step, the entities may have moved
+	void begin_step();
+
+	// Check if the meshes of a and b (see registry.meshPtrs) overlap
+	bool overlaps(Entity a, Entity b);
+
+private:
+	static constexpr float epsilon = 1e-3f;
+
+	std::vector<WorldMesh> meshes;
+	size_t used = 0;
+	std::unordered_map<unsigned int, size_t> slot_of;
+
+	// Triangles (index of their first index) of each mesh that reach into the other's box
+	std::vector<unsigned int> candidates_a, candidates_b;
+
+	// Slot in 'meshes' of the world mesh of e, transformed on first use in a step
+	size_t world_mesh(Entity e);
+};
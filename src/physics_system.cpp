@@ -3,6 +3,14 @@
 #include "world_init.hpp"
 #include <iostream>
 
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define PHYSICS_SSE
+#endif
+
+// Grid cell size of the collision broad phase, 0 picks one from the bodies (see BroadPhase::set_cell_size)
+float collisionCellSize = 0.f;
+
 // Returns the local bounding coordinates scaled by the current size of the entity
 vec2 get_bounding_box(const Motion& motion)
 {
@@ -13,17 +21,8 @@ vec2 get_bounding_box(const Motion& motion)
 vec2 PhysicsSystem::get_custom_bounding_box(Entity entity)
 {
 	Motion& motion = registry.motions.get(entity);
-	if(registry.companions.has(entity) || registry.enemies.has(entity)){
-		int type;
-		
-		if(registry.companions.has(entity)){
-			Companion& companion = registry.companions.get(entity);
-			type = companion.companionType;
-		} else {
-			Enemy& enemy = registry.enemies.get(entity);
-			type = enemy.enemyType;
-		}
-
+	int type = registry.characters.type_of(entity);
+	if(type != 0){
 		if(type==MAGE){
 			return { abs(motion.scale.x), abs(motion.scale.y)/1.5 };
 		} else if(type==SWORDSMAN){
@@ -46,60 +45,66 @@ vec2 PhysicsSystem::get_custom_bounding_box(Entity entity)
 	}
 }
 
-vec2 PhysicsSystem::get_custom_position(Entity entity)
+vec2 PhysicsSystem::get_custom_offset(Entity entity)
 {
 	Motion& motion = registry.motions.get(entity);
-	if(registry.companions.has(entity) || registry.enemies.has(entity)){
-		int type;
-		
-		if(registry.companions.has(entity)){
-			Companion& companion = registry.companions.get(entity);
-			type = companion.companionType;
-		} else {
-			Enemy& enemy = registry.enemies.get(entity);
-			type = enemy.enemyType;
-		}
-
-		if(type==MAGE){
-			float offset = motion.scale.y/4;
-			return {motion.position.x, motion.position.y+offset};
-		} else if(type==SWORDSMAN){
-			float offset_y = motion.scale.y/5;
-			float offset_x = motion.scale.x/12;
-			return {motion.position.x-offset_x, motion.position.y+offset_y};
-		} else if(type==NECROMANCER_ONE){
-			return motion.position;
-		} else{
-			return motion.position;
-		}
-
-	} else {
-		return motion.position;
+	int type = registry.characters.type_of(entity);
+	if(type==MAGE){
+		return {0.f, motion.scale.y/4};
+	} else if(type==SWORDSMAN){
+		return {-(motion.scale.x/12), motion.scale.y/5};
 	}
+	return {0.f, 0.f};
 }
 
+vec2 PhysicsSystem::get_custom_position(Entity entity)
+{
+	return registry.motions.get(entity).position + get_custom_offset(entity);
+}
 
+CollisionShape PhysicsSystem::compute_shape(Entity entity)
+{
+	CollisionShape shape;
+	shape.offset = get_custom_offset(entity);
+	shape.half_extents = get_custom_bounding_box(entity) / 2.f;
+	shape.scale = registry.motions.get(entity).scale;
+	return shape;
+}
+
+void PhysicsSystem::update_shapes()
+{
+	ComponentContainer<Collider>& collider_container = registry.colliders;
+	ComponentContainer<CollisionShape>& shape_container = registry.collisionShapes;
+	for (uint i = 0; i < collider_container.size(); i++)
+	{
+		Entity entity = collider_container.entities[i];
+		if (!registry.motions.has(entity))
+			continue;
+		if (!shape_container.has(entity))
+			shape_container.insert(entity, compute_shape(entity));
+		else if (shape_container.get(entity).scale != registry.motions.get(entity).scale)
+			shape_container.get(entity) = compute_shape(entity);
+	}
+}
 
 // This is a SUPER APPROXIMATE check that puts a circle around the bounding boxes and sees
 // if the center point of either object is inside the other's bounding-box-circle. You can
 // surely implement a more accurate detection
-bool collides(const Entity entity_i, const Entity entity_j)
+bool collides(const CollisionBody& body_i, const CollisionBody& body_j)
 {
-	PhysicsSystem ps;
-	vec2 custom_pos_i = ps.get_custom_position(entity_i);
-	vec2 custom_pos_j = ps.get_custom_position(entity_j);
+	vec2 custom_pos_i = body_i.center;
+	vec2 custom_pos_j = body_j.center;
 	vec2 dp = custom_pos_i - custom_pos_j;
 	float dist_squared = dot(dp,dp);
-	const vec2 other_bonding_box = ps.get_custom_bounding_box(entity_i) / 2.f;
+	const vec2 other_bonding_box = body_i.half_extents;
 	const float other_r_squared = dot(other_bonding_box, other_bonding_box);
-	const vec2 my_bonding_box = ps.get_custom_bounding_box(entity_j) / 2.f;
+	const vec2 my_bonding_box = body_j.half_extents;
 	const float my_r_squared = dot(my_bonding_box, my_bonding_box);
 	const float r_squared = max(other_r_squared, my_r_squared);
 
-	if(registry.reflects.has(entity_i)){
-		Motion motion_j = registry.motions.get(entity_j);
+	if(body_i.reflects){
 		int dir = 1;
-		if(motion_j.velocity.x < 0){
+		if(body_j.velocity.x < 0){
 			dir = -1;
 		}
 		int left_x_i = custom_pos_i.x - other_bonding_box.x;
@@ -120,10 +125,9 @@ bool collides(const Entity entity_i, const Entity entity_j)
 			return false;
 		}
 	}
-	else if(registry.reflects.has(entity_j)){
-		Motion motion_i = registry.motions.get(entity_i);
+	else if(body_j.reflects){
 		int dir = 1;
-		if(motion_i.velocity.x < 0){
+		if(body_i.velocity.x < 0){
 			dir = -1;
 		}
 		int left_x_i = custom_pos_i.x - other_bonding_box.x;
@@ -151,6 +155,38 @@ bool collides(const Entity entity_i, const Entity entity_j)
 	return false;
 }
 
+// Continuous test for bodies that moved by their displacement during the step
+// a's box is swept relative to b's box, which is the segment from the relative start position against b's box grown
+// by a's half extents. On a hit, time_of_impact is the fraction of the step at which the boxes first touch.
+bool sweptCollides(const CollisionBody& body_a, const CollisionBody& body_b, float& time_of_impact)
+{
+	vec2 start = (body_a.center - body_a.displacement) - (body_b.center - body_b.displacement);
+	vec2 path = body_a.displacement - body_b.displacement;
+	vec2 extents = body_a.half_extents + body_b.half_extents;
+
+	// Clip the segment against the slabs of both axes
+	float t_enter = 0.f, t_exit = 1.f;
+	for (int axis = 0; axis < 2; axis++)
+	{
+		if (path[axis] == 0.f)
+		{
+			if (abs(start[axis]) > extents[axis])
+				return false;
+			continue;
+		}
+		float t0 = (-extents[axis] - start[axis]) / path[axis];
+		float t1 = (extents[axis] - start[axis]) / path[axis];
+		if (t0 > t1)
+			std::swap(t0, t1);
+		t_enter = max(t_enter, t0);
+		t_exit = min(t_exit, t1);
+		if (t_enter > t_exit)
+			return false;
+	}
+	time_of_impact = t_enter;
+	return true;
+}
+
 bool fireflyCollides(const Entity entity_i, const Entity entity_j) {
 	PhysicsSystem ps;
 	vec2 custom_pos_i = ps.get_custom_position(entity_i);
@@ -170,72 +206,185 @@ bool fireflyCollides(const Entity entity_i, const Entity entity_j) {
 }
 
 
-// https://www.geeksforgeeks.org/check-whether-a-given-point-lies-inside-a-triangle-or-not/
-float area(float x1, float y1, float x2, float y2, float x3, float y3)
+void MotionArrays::resize(size_t n)
 {
-   return abs((x1*(y2-y3) + x2*(y3-y1)+ x3*(y1-y2))/2.0);
+	position_x.resize(n);
+	position_y.resize(n);
+	velocity_x.resize(n);
+	velocity_y.resize(n);
+	acceleration_x.resize(n);
+	acceleration_y.resize(n);
 }
 
-// https://www.geeksforgeeks.org/check-whether-a-given-point-lies-inside-a-triangle-or-not/
-bool isInside(vec3 point1, vec3 point2, vec3 point3, vec3 p)
+// Explicit Euler step over n bodies, four at a time with SSE and the remainder one by one
+// The operations are the same as the scalar code (v + dt*a, then p + dt*v), so the results match bit for bit
+static void integrate_kernel(size_t n, float dt, float* px, float* py, float* vx, float* vy, const float* ax, const float* ay)
 {
-	float A = area(point1.x, point1.y, point2.x, point2.y, point3.x, point3.y);
-	float A1 = area(p.x, p.y, point2.x, point2.y, point3.x, point3.y);
-	float A2 = area(point1.x, point1.y, p.x, p.y, point3.x, point3.y);
-	float A3 = area(point1.x, point1.y, point2.x, point2.y, p.x, p.y);
-	return (A == (A1 + A2 + A3));
+	size_t i = 0;
+#ifdef PHYSICS_SSE
+	const __m128 dt4 = _mm_set1_ps(dt);
+	for (; i + 4 <= n; i += 4)
+	{
+		__m128 vx4 = _mm_add_ps(_mm_loadu_ps(vx + i), _mm_mul_ps(dt4, _mm_loadu_ps(ax + i)));
+		__m128 vy4 = _mm_add_ps(_mm_loadu_ps(vy + i), _mm_mul_ps(dt4, _mm_loadu_ps(ay + i)));
+		_mm_storeu_ps(vx + i, vx4);
+		_mm_storeu_ps(vy + i, vy4);
+		_mm_storeu_ps(px + i, _mm_add_ps(_mm_loadu_ps(px + i), _mm_mul_ps(dt4, vx4)));
+		_mm_storeu_ps(py + i, _mm_add_ps(_mm_loadu_ps(py + i), _mm_mul_ps(dt4, vy4)));
+	}
+#endif
+	for (; i < n; i++)
+	{
+		vx[i] += dt * ax[i];
+		vy[i] += dt * ay[i];
+		px[i] += dt * vx[i];
+		py[i] += dt * vy[i];
+	}
 }
 
+// Items per chunk when integration and the pair tests are split across threads, smaller loops stay on one thread
+static const size_t integrate_grain = 2048;
+static const size_t pair_grain = 4096;
+
+const unsigned int PhysicsSystem::sleep_steps;
 
-bool precise_collides(Entity entity1, Entity entity2)
+BodyType PhysicsSystem::body_type(Entity entity)
 {
-	Motion& motion1 = registry.motions.get(entity1);
-	Motion& motion2 = registry.motions.get(entity2);
-	
-	Mesh* mesh1 = registry.meshPtrs.get(entity1);
-	Mesh* mesh2 = registry.meshPtrs.get(entity2);
-	
-	// Go over the first entity's faces
-	for(int i = 0; i<mesh1->vertex_indices.size(); i=i+3){
-		// vertex indices in a triangle face
-		uint16_t ind1 = mesh1->vertex_indices[i];
-		uint16_t ind2 = mesh1->vertex_indices[i+1];
-		uint16_t ind3 = mesh1->vertex_indices[i+2];
-		
-		// vertices of the triangle
-		std::vector<ColoredVertex> coloredVerteces = mesh1->vertices;
-		vec3 point1 = {coloredVerteces[ind1].position.x, coloredVerteces[ind1].position.y, 1.f};
-		vec3 point2 = {coloredVerteces[ind2].position.x, coloredVerteces[ind2].position.y, 1.f};
-		vec3 point3 = {coloredVerteces[ind3].position.x, coloredVerteces[ind3].position.y, 1.f};
-		
-		// vertices of the triangle in world coor
-		Transform transform1;
-		transform1.translate(motion1.position);
-		transform1.rotate(motion1.angle);
-		transform1.scale(motion1.scale);
-
-		point1 = transform1.mat*point1;
-		point2 = transform1.mat*point2;
-		point3 = transform1.mat*point3;
-		
-		// Go over the second entity's vertices
-		for(ColoredVertex cv: mesh2->vertices){
-			vec3 vertex = {cv.position.x, cv.position.y, 1.f};
-			
-			// vertex in world coor
-			Transform transform2;
-			transform2.translate(motion2.position);
-			transform2.rotate(motion2.angle);
-			transform2.scale(motion2.scale);
-
-			vertex = transform2.mat*vertex;
-
-			if(isInside(point1, point2, point3, vertex)){
-				return true;
-			}
+	if (registry.rigidBodies.has(entity))
+		return registry.rigidBodies.get(entity).type;
+	// Placed by resolve_attachments
+	if (registry.attachments.has(entity))
+		return BodyType::KINEMATIC;
+	return BodyType::DYNAMIC;
+}
+
+PhysicsSystem::SleepState& PhysicsSystem::sleep_state(Entity entity)
+{
+	if (entity.index() >= sleep_states.size())
+		sleep_states.resize(entity.index() + 1);
+	SleepState& state = sleep_states[entity.index()];
+	if (state.entity != entity)
+	{
+		// New entity, or a new one on a re-used index
+		state = SleepState();
+		state.entity = entity;
+		state.type = body_type(entity);
+		state.position = registry.motions.get(entity).position;
+		state.rest_steps = 0;
+		state.asleep = false;
+		state.listed = false;
+		state.passive_step = ~0u;
+	}
+	return state;
+}
+
+void PhysicsSystem::wake(Entity entity)
+{
+	SleepState& state = sleep_state(entity);
+	state.rest_steps = 0;
+	state.asleep = false;
+	if (!state.listed)
+	{
+		state.listed = true;
+		awake_entities.push_back(entity);
+	}
+}
+
+bool PhysicsSystem::asleep(Entity entity) const
+{
+	return entity.index() < sleep_states.size() && sleep_states[entity.index()].entity == entity
+		&& sleep_states[entity.index()].asleep;
+}
+
+void PhysicsSystem::update_sleep()
+{
+	ComponentContainer<Motion>& motion_container = registry.motions;
+
+	// Writing to the motion of a body, or changing its type, wakes it. The first step finds every motion in the log.
+	motion_container.track_changes();
+	registry.rigidBodies.track_changes();
+	registry.attachments.track_changes();
+	motion_container.drain_changes([this](Entity entity) { wake(entity); });
+	auto wake_moving = [this, &motion_container](Entity entity) {
+		if (motion_container.has(entity))
+			wake(entity);
+	};
+	registry.rigidBodies.drain_changes(wake_moving);
+	registry.attachments.drain_changes(wake_moving);
+
+	// Only the awake bodies are looked at, those that fall asleep or lost their motion leave the list
+	awake_motions.clear();
+	size_t kept = 0;
+	for (Entity entity : awake_entities)
+	{
+		if (!motion_container.has(entity))
+		{
+			// The state may belong to a new entity on the same index by now
+			if (sleep_states[entity.index()].entity == entity)
+				sleep_states[entity.index()].listed = false;
+			continue;
 		}
+		Motion& motion = motion_container.get(entity);
+		SleepState& state = sleep_state(entity);
+		state.type = body_type(state.entity);
+
+		// A body rests while it keeps its position and, if dynamic, has no velocity or acceleration
+		bool unchanged = motion.position == state.position;
+		bool resting = false;
+		if (state.type == BodyType::STATIC)
+			resting = unchanged;
+		else if (state.type == BodyType::DYNAMIC)
+			resting = unchanged && motion.velocity == vec2(0.f) && motion.acceleration == vec2(0.f);
+		state.rest_steps = resting ? std::min(state.rest_steps + 1, sleep_steps) : 0;
+		state.asleep = state.rest_steps >= (state.type == BodyType::STATIC ? 1u : sleep_steps);
+		state.position = motion.position;
+
+		if (state.asleep)
+		{
+			state.listed = false;
+			continue;
+		}
+		awake_entities[kept++] = entity;
+		if (state.type != BodyType::STATIC)
+			awake_motions.push_back(&motion);
 	}
-	return false;	
+	awake_entities.resize(kept);
+}
+
+void PhysicsSystem::integrate(float step_seconds)
+{
+	step_count++;
+	update_sleep();
+
+	// The workers only touch the awake motions of their chunk
+	const std::vector<Motion*>& awake = awake_motions;
+	size_t n = awake.size();
+	MotionArrays& m = motion_arrays;
+	m.resize(n);
+
+	// Chunks are multiples of four bodies, so the SSE lanes line up as without splitting
+	workers.run(n, integrate_grain, [&](size_t, size_t begin, size_t end) {
+		for (size_t k = begin; k < end; k++)
+		{
+			const Motion& motion = *awake[k];
+			m.position_x[k] = motion.position.x;
+			m.position_y[k] = motion.position.y;
+			m.velocity_x[k] = motion.velocity.x;
+			m.velocity_y[k] = motion.velocity.y;
+			m.acceleration_x[k] = motion.acceleration.x;
+			m.acceleration_y[k] = motion.acceleration.y;
+		}
+
+		integrate_kernel(end - begin, step_seconds, m.position_x.data() + begin, m.position_y.data() + begin,
+			m.velocity_x.data() + begin, m.velocity_y.data() + begin, m.acceleration_x.data() + begin, m.acceleration_y.data() + begin);
+
+		for (size_t k = begin; k < end; k++)
+		{
+			Motion& motion = *awake[k];
+			motion.position = { m.position_x[k], m.position_y[k] };
+			motion.velocity = { m.velocity_x[k], m.velocity_y[k] };
+		}
+	});
 }
 
 void PhysicsSystem::step_freeRoam(float elapsed_ms, float window_width_px, float window_height_px)
@@ -272,191 +421,155 @@ void PhysicsSystem::step_freeRoam(float elapsed_ms, float window_width_px, float
 		bottomRightPoint = vec2(arrowPosX + arrowScaleX / 2 - 50, arrowPosY + arrowScaleY / 2 + 50);
 	}
 
-	for(uint i = 0; i< motion_registry.size(); i++)
-	{
-		Motion* motion = &motion_registry.components[i];
-		Entity entity = motion_registry.entities[i];
-		float step_seconds = 1.0f * (elapsed_ms / 1000.f);
-
-		// Handle firefly movement:
-		if (registry.fireflySwarm.has(entity)) {
-
-			// 1. Avoidance movement: Separate from the incoming arrow
-			if (hasArrow && fireflyCollides(entity, arrow_entity)) {
-				vec2 fireflyPos = motion->position;
-				float moveValue = 200;
-				float timerValue = 100.f;
-				auto& firefly = registry.fireflySwarm.get(entity);
-
-				// Separate the arrow's collision box into four cases as below
-
-				// First case: Within top-left collision box of arrow
-				if (topLeftPoint.x <= fireflyPos.x
-					&& fireflyPos.x <= arrowPosX
-					&& topLeftPoint.y <= fireflyPos.y
-					&& fireflyPos.y <= arrowPosY && !firefly.isDodging) {
-					firefly.beforeDodgeVelX = motion->velocity.x;
-					firefly.beforeDodgeVelY = motion->velocity.y;
-					motion->velocity.x = moveValue;
-					motion->velocity.y = moveValue;
-					firefly.dodge_timer = timerValue;
-					firefly.isDodging = 1;
-					registry.projectiles.get(arrow_entity).empoweredArrow = 1;
-				}
-
-				// Second case: Within top-right collision box of arrow
-				else if (arrowPosX < fireflyPos.x
-					   && fireflyPos.x <= topRightPoint.x
-					   && topRightPoint.y <= fireflyPos.y
-					   && fireflyPos.y < arrowPosY && !firefly.isDodging) {
-					firefly.beforeDodgeVelX = motion->velocity.x;
-					firefly.beforeDodgeVelY = motion->velocity.y;
-					motion->velocity.x = moveValue;
-					motion->velocity.y = moveValue;
-					firefly.dodge_timer = timerValue;
-					firefly.isDodging = 1;
-					registry.projectiles.get(arrow_entity).empoweredArrow = 1;
-				}
-
-				// Third case: Within bottom-left collision box of arrow
-				else if (bottomLeftPoint.x <= fireflyPos.x
-					   && fireflyPos.x < arrowPosX
-					   && arrowPosY < fireflyPos.y
-					   && fireflyPos.y <= bottomLeftPoint.y && !firefly.isDodging) {
-					firefly.beforeDodgeVelX = motion->velocity.x;
-					firefly.beforeDodgeVelY = motion->velocity.y;
-					motion->velocity.x = moveValue;
-					motion->velocity.y = moveValue;
-					firefly.dodge_timer = timerValue;
-					firefly.isDodging = 1;
-					registry.projectiles.get(arrow_entity).empoweredArrow = 1;
-				}
-
-				// Fourth case: Within bottom-right collision box of arrow
-				else if (arrowPosX <= fireflyPos.x
-					   && fireflyPos.x <= bottomRightPoint.x
-					   && arrowPosY <= fireflyPos.y
-					   && fireflyPos.y <= bottomRightPoint.y && !firefly.isDodging) {
-					firefly.beforeDodgeVelX = motion->velocity.x;
-					firefly.beforeDodgeVelY = motion->velocity.y;
-					motion->velocity.x = moveValue;
-					motion->velocity.y = moveValue;
-					firefly.dodge_timer = timerValue;
-					firefly.isDodging = 1;
-					registry.projectiles.get(arrow_entity).empoweredArrow = 1;
-				}
-			}
-
-			// 2. Standard movement: Moves towards a boundary and bounces back after approaching
-			float posX = motion->position.x;
-			float posY = motion->position.y;
-			auto& fireflyComoponent = registry.fireflySwarm.get(entity);
+	float step_seconds = 1.0f * (elapsed_ms / 1000.f);
 
-			// Bounce x
-			if (fireflyComoponent.shouldFlipVelocityX == 1) {
-				motion->velocity.x = abs(motion->velocity.x);
-			}
-			else if (fireflyComoponent.shouldFlipVelocityX == 2) {
-				motion->velocity.x = -abs(motion->velocity.x);
+	// Handle firefly movement:
+	ComponentContainer<SwarmParticle>& firefly_container = registry.fireflySwarm;
+	for (uint i = 0; i < firefly_container.size(); i++)
+	{
+		Entity entity = firefly_container.entities[i];
+		if (!motion_registry.has(entity))
+			continue;
+		Motion* motion = &motion_registry.get_mut(entity);
+
+		// 1. Avoidance movement: Separate from the incoming arrow
+		if (hasArrow && fireflyCollides(entity, arrow_entity)) {
+			vec2 fireflyPos = motion->position;
+			float moveValue = 200;
+			float timerValue = 100.f;
+			auto& firefly = registry.fireflySwarm.get(entity);
+
+			// Separate the arrow's collision box into four cases as below
+
+			// First case: Within top-left collision box of arrow
+			if (topLeftPoint.x <= fireflyPos.x
+				&& fireflyPos.x <= arrowPosX
+				&& topLeftPoint.y <= fireflyPos.y
+				&& fireflyPos.y <= arrowPosY && !firefly.isDodging) {
+				firefly.beforeDodgeVelX = motion->velocity.x;
+				firefly.beforeDodgeVelY = motion->velocity.y;
+				motion->velocity.x = moveValue;
+				motion->velocity.y = moveValue;
+				firefly.dodge_timer = timerValue;
+				firefly.isDodging = 1;
+				registry.projectiles.get(arrow_entity).empoweredArrow = 1;
+			}
+
+			// Second case: Within top-right collision box of arrow
+			else if (arrowPosX < fireflyPos.x
+				   && fireflyPos.x <= topRightPoint.x
+				   && topRightPoint.y <= fireflyPos.y
+				   && fireflyPos.y < arrowPosY && !firefly.isDodging) {
+				firefly.beforeDodgeVelX = motion->velocity.x;
+				firefly.beforeDodgeVelY = motion->velocity.y;
+				motion->velocity.x = moveValue;
+				motion->velocity.y = moveValue;
+				firefly.dodge_timer = timerValue;
+				firefly.isDodging = 1;
+				registry.projectiles.get(arrow_entity).empoweredArrow = 1;
+			}
+
+			// Third case: Within bottom-left collision box of arrow
+			else if (bottomLeftPoint.x <= fireflyPos.x
+				   && fireflyPos.x < arrowPosX
+				   && arrowPosY < fireflyPos.y
+				   && fireflyPos.y <= bottomLeftPoint.y && !firefly.isDodging) {
+				firefly.beforeDodgeVelX = motion->velocity.x;
+				firefly.beforeDodgeVelY = motion->velocity.y;
+				motion->velocity.x = moveValue;
+				motion->velocity.y = moveValue;
+				firefly.dodge_timer = timerValue;
+				firefly.isDodging = 1;
+				registry.projectiles.get(arrow_entity).empoweredArrow = 1;
+			}
+
+			// Fourth case: Within bottom-right collision box of arrow
+			else if (arrowPosX <= fireflyPos.x
+				   && fireflyPos.x <= bottomRightPoint.x
+				   && arrowPosY <= fireflyPos.y
+				   && fireflyPos.y <= bottomRightPoint.y && !firefly.isDodging) {
+				firefly.beforeDodgeVelX = motion->velocity.x;
+				firefly.beforeDodgeVelY = motion->velocity.y;
+				motion->velocity.x = moveValue;
+				motion->velocity.y = moveValue;
+				firefly.dodge_timer = timerValue;
+				firefly.isDodging = 1;
+				registry.projectiles.get(arrow_entity).empoweredArrow = 1;
 			}
+		}
 
-			// Bounce y
-			if (fireflyComoponent.shouldFlipVelocityY == 1) {
-				motion->velocity.y = abs(motion->velocity.y);
-			}
-			else if (fireflyComoponent.shouldFlipVelocityY == 2) {
-				motion->velocity.y = -abs(motion->velocity.y);
-			}
+		// 2. Standard movement: Moves towards a boundary and bounces back after approaching
+		float posX = motion->position.x;
+		float posY = motion->position.y;
+		auto& fireflyComoponent = registry.fireflySwarm.get(entity);
 
-			if (posX - xBorderLimitDist < 0.f) {
-				fireflyComoponent.shouldFlipVelocityX = 1;
-			}
-			else if (posX + xBorderLimitDist >= window_width_px) {
-				fireflyComoponent.shouldFlipVelocityX = 2;
-			}
-			else {
-				fireflyComoponent.shouldFlipVelocityX = 0;
-			}
-			if (posY - yBorderLimitDist < 0.f) {
-				fireflyComoponent.shouldFlipVelocityY = 1;
-			}
-			else if (posY + yBorderLimitDist >= window_height_px) {
-				fireflyComoponent.shouldFlipVelocityY = 2;
-			}
-			else {
-				fireflyComoponent.shouldFlipVelocityY = 0;
-			}
+		// Bounce x
+		if (fireflyComoponent.shouldFlipVelocityX == 1) {
+			motion->velocity.x = abs(motion->velocity.x);
+		}
+		else if (fireflyComoponent.shouldFlipVelocityX == 2) {
+			motion->velocity.x = -abs(motion->velocity.x);
 		}
 
-		//normal movement
-		motion->velocity.x += step_seconds * motion->acceleration.x;
-		motion->velocity.y += step_seconds * motion->acceleration.y;
-		motion->position.x += step_seconds * motion->velocity.x;
-		motion->position.y += step_seconds * motion->velocity.y;
-
-		//gravity effect
-		if (registry.gravities.has(entity)) {
+		// Bounce y
+		if (fireflyComoponent.shouldFlipVelocityY == 1) {
+			motion->velocity.y = abs(motion->velocity.y);
+		}
+		else if (fireflyComoponent.shouldFlipVelocityY == 2) {
+			motion->velocity.y = -abs(motion->velocity.y);
+		}
 
-			if (registry.companions.has(entity) && registry.companions.get(entity).companionType == ARCHER) {
-				if (motion->velocity.y != 0) {
-					motion->acceleration.y += registry.gravities.get(entity).gravity;
-				}
-				continue;
-			}
-			motion->acceleration.y += registry.gravities.get(entity).gravity;
-			float angle = atan(motion->velocity.y / motion->velocity.x);
-			if (motion->velocity.x < 0) {
-				angle += M_PI;
-			}
-			motion->angle = angle;
+		if (posX - xBorderLimitDist < 0.f) {
+			fireflyComoponent.shouldFlipVelocityX = 1;
+		}
+		else if (posX + xBorderLimitDist >= window_width_px) {
+			fireflyComoponent.shouldFlipVelocityX = 2;
+		}
+		else {
+			fireflyComoponent.shouldFlipVelocityX = 0;
+		}
+		if (posY - yBorderLimitDist < 0.f) {
+			fireflyComoponent.shouldFlipVelocityY = 1;
+		}
+		else if (posY + yBorderLimitDist >= window_height_px) {
+			fireflyComoponent.shouldFlipVelocityY = 2;
+		}
+		else {
+			fireflyComoponent.shouldFlipVelocityY = 0;
 		}
 	}
 
-	// Check for collisions between all moving entities
-	ComponentContainer<Motion>& motion_container = registry.motions;
-	for (uint i = 0; i < motion_container.components.size(); i++)
-	{
-		Motion& motion_i = motion_container.components[i];
-		Entity entity_i = motion_container.entities[i];
-		for (uint j = 0; j < motion_container.components.size(); j++) // i+1
-		{
-			if (i == j)
-				continue;
+	//normal movement
+	integrate(step_seconds);
 
-			Motion& motion_j = motion_container.components[j];
-			Entity entity_j = motion_container.entities[j];
+	//gravity effect
+	ComponentContainer<Gravity>& gravity_container = registry.gravities;
+	for (uint i = 0; i < gravity_container.size(); i++)
+	{
+		Entity entity = gravity_container.entities[i];
+		if (!motion_registry.has(entity))
+			continue;
+		Motion* motion = &motion_registry.get_mut(entity);
 
-			// Handle charIndicator following the character here
-			if (registry.charIndicator.has(entity_i) && registry.charIndicator.get(entity_i).owner == entity_j) {
-				motion_i.position = vec2(motion_j.position.x, motion_i.position.y);
-			}
-			else if (registry.charIndicator.has(entity_j) && registry.charIndicator.get(entity_j).owner == entity_i) {
-				motion_j.position = vec2(motion_i.position.x, motion_j.position.y);
-			}
-			
-			if (collides(entity_i, entity_j))
-			{
-				if((registry.preciseColliders.has(entity_i) && registry.preciseColliders.has(entity_j))&&
-					!(registry.boulders.has(entity_i) && registry.boulders.has(entity_j)))
-				{
-					if(precise_collides(entity_i, entity_j))
-					{
-						// Create a collisions event
-						// We are abusing the ECS system a bit in that we potentially insert muliple collisions for the same entity
-						registry.collisions.emplace_with_duplicates(entity_i, entity_j);
-						registry.collisions.emplace_with_duplicates(entity_j, entity_i);	
-					}
-				} else
-				{
-					// Create a collisions event
-					// We are abusing the ECS system a bit in that we potentially insert muliple collisions for the same entity
-					registry.collisions.emplace_with_duplicates(entity_i, entity_j);
-					registry.collisions.emplace_with_duplicates(entity_j, entity_i);
-				}
+		if (registry.companions.has(entity) && registry.companions.get(entity).companionType == ARCHER) {
+			if (motion->velocity.y != 0) {
+				motion->acceleration.y += gravity_container.components[i].gravity;
 			}
+			continue;
 		}
+		motion->acceleration.y += gravity_container.components[i].gravity;
+		float angle = atan(motion->velocity.y / motion->velocity.x);
+		if (motion->velocity.x < 0) {
+			angle += M_PI;
+		}
+		motion->angle = angle;
 	}
 
+	resolve_attachments();
+
+	// Check for collisions between all moving entities, with the precise mesh test where both have meshes
+	detect_collisions(true, step_seconds);
+
 	// debugging of bounding boxes
 	if (debugging.in_debug_mode) showDebugBox();
 }
@@ -466,120 +579,180 @@ void PhysicsSystem::step(float elapsed_ms, float window_width_px, float window_h
 
 
 	auto& motion_registry = registry.motions;
-	for(uint i = 0; i< motion_registry.size(); i++)
-	{
-		Motion* motion = &motion_registry.components[i];
-		Entity entity = motion_registry.entities[i];
-		float step_seconds = 1.0f * (elapsed_ms / 1000.f);
+	float step_seconds = 1.0f * (elapsed_ms / 1000.f);
 
-		//gravity effect
-		if (registry.gravities.has(entity)){
-			motion->acceleration.y += registry.gravities.get(entity).gravity;
-		}
+	//gravity effect, the entities with gravity are a contiguous subset in their own container
+	ComponentContainer<Gravity>& gravity_container = registry.gravities;
+	for (uint i = 0; i < gravity_container.size(); i++)
+	{
+		Entity entity = gravity_container.entities[i];
+		if (motion_registry.has(entity))
+			motion_registry.get_mut(entity).acceleration.y += gravity_container.components[i].gravity;
+	}
 
-		//normal movement
-		motion->velocity.x += step_seconds * motion->acceleration.x;
-		motion->velocity.y += step_seconds * motion->acceleration.y;
-		motion->position.x += step_seconds * motion->velocity.x;
-		motion->position.y += step_seconds * motion->velocity.y;
+	//normal movement
+	integrate(step_seconds);
 
-		if (registry.gravities.has(entity)) {
-			float angle = atan(motion->velocity.y / motion->velocity.x);
-			if (motion->velocity.x < 0) {
-				angle += M_PI;
-			}
-			motion->angle = angle;
+	for (uint i = 0; i < gravity_container.size(); i++)
+	{
+		Entity entity = gravity_container.entities[i];
+		if (!motion_registry.has(entity))
+			continue;
+		Motion* motion = &motion_registry.get(entity);
+		float angle = atan(motion->velocity.y / motion->velocity.x);
+		if (motion->velocity.x < 0) {
+			angle += M_PI;
 		}
+		motion->angle = angle;
 	}
 
-	// make sure each stat indicator is with their owner
-	ComponentContainer<StatIndicator>& statsid_container = registry.statsindicators;
-	for (uint i = 0; i < statsid_container.components.size(); i++)
-	{
-		Motion* motion_i = &registry.motions.get(statsid_container.entities[i]);
+	// Indicators and health bars follow their owners
+	resolve_attachments();
 
-		if (registry.motions.has(statsid_container.components[i].owner)) {
-			Motion motion_o = registry.motions.get(statsid_container.components[i].owner);
-			motion_i->position.x = motion_o.position.x + 20;
-			motion_i->position.y = motion_o.position.y - 50;
+	// Check for collisions between all moving entities
+	detect_collisions(false, step_seconds);
 
-			//lower it for mage 
-			if (registry.enemies.has(statsid_container.components[i].owner) && registry.enemies.get(statsid_container.components[i].owner).enemyType == MAGE) {
-				motion_i->position.y += 30;
-			}
-			if (registry.companions.has(statsid_container.components[i].owner) && registry.companions.get(statsid_container.components[i].owner).companionType == MAGE) {
-				motion_i->position.y += 30;
-			}
-		}
-	}
+	// you may need the following quantities to compute wall positions
+	(float)window_width_px; (float)window_height_px;
 
-	// make sure each bleed indicator is with their owner
-	ComponentContainer<BleedIndicator>& bleed_container = registry.bleedIndicators;
-	for (uint i = 0; i < bleed_container.components.size(); i++)
-	{
-		Motion* motion_i = &registry.motions.get(bleed_container.entities[i]);
 
-		if (registry.motions.has(bleed_container.components[i].owner)) {
-			Motion motion_o = registry.motions.get(bleed_container.components[i].owner);
-			motion_i->position.x = motion_o.position.x + 20;
-			motion_i->position.y = motion_o.position.y - 30;
+	// debugging of bounding boxes
+	if (debugging.in_debug_mode) showDebugBox();
+}
 
-			//lower it for mage 
-			if (registry.enemies.has(bleed_container.components[i].owner) && registry.enemies.get(bleed_container.components[i].owner).enemyType == MAGE) {
-				motion_i->position.y += 30;
-			}
-			if (registry.companions.has(bleed_container.components[i].owner) && registry.companions.get(bleed_container.components[i].owner).companionType == MAGE) {
-				motion_i->position.y += 30;
-			}
-		}
-	}
+void PhysicsSystem::resolve_attachments()
+{
+	ComponentContainer<Attachment>& attachments = registry.attachments;
+	ComponentContainer<Motion>& motions = registry.motions;
 
-	// Check for collisions between all moving entities
-    ComponentContainer<Motion> &motion_container = registry.motions;
-	for(uint i = 0; i<motion_container.components.size(); i++)
+	// Parents before their children: order by the number of attached ancestors, keeping the container order
+	// The order is only rebuilt after attachments were added, removed or modified
+	if (attachments.structure_version() != attachment_version || attachments.current_tick() != attachment_tick)
 	{
-		Motion& motion_i = motion_container.components[i];
-		Entity entity_i = motion_container.entities[i];
-		for(uint j = 0; j<motion_container.components.size(); j++) // i+1
+		attachment_order.clear();
+		for (uint i = 0; i < attachments.size(); i++)
 		{
-			if (i == j)
-				continue;
+			unsigned int depth = 0;
+			for (Entity e = attachments.components[i].parent; attachments.has(e); e = attachments.get(e).parent)
+				depth++;
+			attachment_order.emplace_back(depth, i);
+		}
+		std::sort(attachment_order.begin(), attachment_order.end());
+		attachment_version = attachments.structure_version();
+		attachment_tick = attachments.current_tick();
+	}
 
-			Motion& motion_j = motion_container.components[j];
-			Entity entity_j = motion_container.entities[j];
+	for (const std::pair<unsigned int, unsigned int>& entry : attachment_order)
+	{
+		Entity child = attachments.entities[entry.second];
+		const Attachment& attachment = attachments.components[entry.second];
+		if (motions.has(child) && motions.has(attachment.parent))
+			motions.get(child).position = motions.get(attachment.parent).position + attachment.offset;
+	}
+}
 
-			// Handle charIndicator following the character here
-			if (registry.charIndicator.has(entity_i) && registry.charIndicator.get(entity_i).owner == entity_j) {
-				motion_i.position = vec2(motion_j.position.x, motion_i.position.y);
-			}
-			else if (registry.charIndicator.has(entity_j) && registry.charIndicator.get(entity_j).owner == entity_i) {
-				motion_j.position = vec2(motion_i.position.x, motion_j.position.y);
-			}
+void PhysicsSystem::detect_collisions(bool precise, float step_seconds)
+{
+	ComponentContainer<Motion>& motion_container = registry.motions;
 
+	update_shapes();
+	narrow_phase.begin_step();
+	contact_cache.begin_step();
+
+	// Only moving entities with a collider that accepts anything take part, in the order of the motions
+	// Reflecting bodies collide along a whole side (see collides), so they are tested against everything
+	ComponentContainer<Collider>& collider_container = registry.colliders;
+	ComponentContainer<CollisionShape>& shape_container = registry.collisionShapes;
+	broad_phase.set_cell_size(collisionCellSize);
+	broad_phase.clear();
+	bodies.clear();
+	for (uint i = 0; i < motion_container.components.size(); i++)
+	{
+		Entity entity = motion_container.entities[i];
+		if (!collider_container.has(entity) || collider_container.get(entity).mask == 0)
+			continue;
+		const Motion& motion = motion_container.components[i];
+		const CollisionShape& shape = shape_container.get(entity);
+		const Collider& collider = collider_container.get(entity);
+		vec2 displacement = registry.projectiles.has(entity) ? motion.velocity * step_seconds : vec2(0.f);
+		CollisionBody body = { entity, motion.position + shape.offset, shape.half_extents, motion.velocity, displacement,
+			collider.category, collider.mask, registry.reflects.has(entity) };
+		bodies.push_back(body);
+		// Resting bodies are only tested against the others, their pairs among themselves stay as they were
+		bool passive = asleep(entity);
+		if (passive)
+			sleep_states[entity.index()].passive_step = step_count;
+		// A projectile that moved further than its own size may hit something its end position is not near
+		float radius = length(body.half_extents);
+		broad_phase.add(body.center, radius, body.reflects || length(displacement) > radius, passive);
+	}
 
-			//if (collides(motion_i, motion_j))
-			if(collides(entity_i, entity_j))
+	// The candidates come in both orders and the tests are symmetric, so each pair is tested once
+	// The box tests only read 'bodies' and run on the workers, the mesh test needs the registry and stays here
+	const std::vector<std::pair<unsigned int, unsigned int>>& candidates = broad_phase.find_pairs(&workers);
+	size_t chunks = WorkerPool::chunk_count(candidates.size(), pair_grain);
+	chunk_hits.resize(std::max(chunk_hits.size(), chunks));
+	workers.run(candidates.size(), pair_grain, [&](size_t chunk, size_t begin, size_t end) {
+		std::vector<Hit>& hits = chunk_hits[chunk];
+		hits.clear();
+		for (size_t k = begin; k < end; k++)
+		{
+			unsigned int i = candidates[k].first, j = candidates[k].second;
+			if (j < i)
+				continue;
+			const CollisionBody& body_i = bodies[i];
+			const CollisionBody& body_j = bodies[j];
+			if (!(body_i.category & body_j.mask) || !(body_j.category & body_i.mask))
+				continue;
+			// Reflecting bodies are tested along a whole side already, so only the others need sweeping
+			float time_of_impact = 1.f;
+			bool swept = false;
+			if (!collides(body_i, body_j))
 			{
-				// Create a collisions event
-				// We are abusing the ECS system a bit in that we potentially insert muliple collisions for the same entity
-				registry.collisions.emplace_with_duplicates(entity_i, entity_j);
-				registry.collisions.emplace_with_duplicates(entity_j, entity_i);
+				if (body_i.reflects || body_j.reflects || (body_i.displacement == vec2(0.f) && body_j.displacement == vec2(0.f)))
+					continue;
+				if (!sweptCollides(body_i, body_j, time_of_impact))
+					continue;
+				swept = true;
 			}
+			hits.push_back({ i, j, time_of_impact, swept });
 		}
-	}
-
-	// you may need the following quantities to compute wall positions
-	(float)window_width_px; (float)window_height_px;
+	});
 
+	for (size_t chunk = 0; chunk < chunks; chunk++)
+		for (const Hit& hit : chunk_hits[chunk])
+		{
+			Entity entity_i = bodies[hit.i].entity;
+			Entity entity_j = bodies[hit.j].entity;
+			// The meshes are only known at the end positions, a swept hit is taken on the boxes alone
+			if (precise && !hit.swept && (registry.preciseColliders.has(entity_i) && registry.preciseColliders.has(entity_j)) &&
+				!(registry.boulders.has(entity_i) && registry.boulders.has(entity_j)))
+			{
+				if (!narrow_phase.overlaps(entity_i, entity_j))
+					continue;
+			}
+			contact_cache.touch(entity_i, entity_j, hit.time_of_impact);
 
-	// debugging of bounding boxes
-	if (debugging.in_debug_mode) showDebugBox();
+			// Touching an awake body wakes a sleeping dynamic one
+			for (Entity entity : { entity_i, entity_j })
+				if (asleep(entity) && sleep_states[entity.index()].type == BodyType::DYNAMIC)
+					wake(entity);
+		}
+	// Pairs of resting bodies were not looked at, they touch as much as they did
+	contact_cache.carry_over([this](Entity a, Entity b) {
+		return sleep_states[a.index()].entity == a && sleep_states[a.index()].passive_step == step_count
+			&& sleep_states[b.index()].entity == b && sleep_states[b.index()].passive_step == step_count;
+	});
+
+	// One begin, stay or end event per pair
+	contact_cache.end_step(registry.contacts);
 }
 
 void PhysicsSystem::showDebugBox() {
 	ComponentContainer<Motion>& motion_container = registry.motions;
-	uint size_before_adding_new = (uint)motion_container.components.size();
-	for (uint i = 0; i < size_before_adding_new; i++)
+	// The lines get their motions on the flush at the end, so the loop only sees the existing entities
+	CommandBuffer commands;
+	for (uint i = 0; i < motion_container.components.size(); i++)
 	{
 
 		Motion& motion_i = motion_container.components[i];
@@ -590,6 +763,10 @@ void PhysicsSystem::showDebugBox() {
 			&& !registry.chests.has(entity_i)) {
 			continue;
 		}
+		if (!registry.collisionShapes.has(entity_i)) {
+			continue;
+		}
+		const CollisionShape& shape = registry.collisionShapes.get(entity_i);
 
 		vec3 point0 = { 0.f, 0.f, 1.f };
 		vec3 pointy = { 0.f, 1.f, 1.f };
@@ -597,8 +774,8 @@ void PhysicsSystem::showDebugBox() {
 		vec3 pointxy = { 1.f, 1.f, 1.f };
 
 		Transform transform;
-		vec2 new_scale = get_custom_bounding_box(entity_i);
-		vec2 custom_pos = get_custom_position(entity_i);
+		vec2 new_scale = shape.half_extents * 2.f;
+		vec2 custom_pos = motion_i.position + shape.offset;
 
 		vec2 offset = { ((cos(motion_i.angle) * new_scale.x) / 2 - (sin(motion_i.angle) * new_scale.y) / 2),
 							((sin(motion_i.angle) * new_scale.x) / 2 + (cos(motion_i.angle) * new_scale.y) / 2) };
@@ -645,12 +822,13 @@ void PhysicsSystem::showDebugBox() {
 		vec2 line3_scale = { line_thickness, (max_y - min_y) };
 
 
-		Entity line1 = createLine(line1_pos, line1_scale);
-		Entity line2 = createLine(line2_pos, line1_scale);
-		Entity line3 = createLine(line3_pos, line3_scale);
-		Entity line4 = createLine(line4_pos, line3_scale);
+		Entity line1 = createLine(commands, line1_pos, line1_scale);
+		Entity line2 = createLine(commands, line2_pos, line1_scale);
+		Entity line3 = createLine(commands, line3_pos, line3_scale);
+		Entity line4 = createLine(commands, line4_pos, line3_scale);
 
 		// center = pos
-		Entity center = createLine(get_custom_position(entity_i), { 5.f, 5.f });
+		Entity center = createLine(commands, custom_pos, { 5.f, 5.f });
 	}
+	commands.flush();
 }
\ No newline at end of file
@@ -4,6 +4,35 @@
 #include "tiny_ecs.hpp"
 #include "components.hpp"
 #include "tiny_ecs_registry.hpp"
+#include "broad_phase.hpp"
+#include "narrow_phase.hpp"
+#include "contact_cache.hpp"
+#include "worker_pool.hpp"
+
+// Structure-of-arrays copy of the integrated Motion fields, one entry per element of registry.motions
+// Motion itself stays a struct since the game holds Motion& all over, the integrator streams through these instead
+struct MotionArrays
+{
+	std::vector<float> position_x, position_y;
+	std::vector<float> velocity_x, velocity_y;
+	std::vector<float> acceleration_x, acceleration_y;
+
+	void resize(size_t n);
+};
+
+// What the narrow phase needs of one collider, gathered once per step from its Motion, CollisionShape and Collider
+struct CollisionBody
+{
+	Entity entity;
+	vec2 center;
+	vec2 half_extents;
+	vec2 velocity;
+	// Distance moved during the step, only set for projectiles which are swept from center - displacement to center
+	vec2 displacement;
+	unsigned int category;
+	unsigned int mask;
+	bool reflects;
+};
 
 // A simple physics system that moves rigid bodies and checks for collision
 class PhysicsSystem
@@ -13,12 +42,81 @@ public:
 	void step_freeRoam(float elapsed_ms, float window_width_px, float window_height_px);
 	vec2 get_custom_position(Entity entity);
 	vec2 get_custom_bounding_box(Entity entity);
+	// Centre of the collision box relative to the entity's position
+	vec2 get_custom_offset(Entity entity);
+	CollisionShape compute_shape(Entity entity);
+	// Compute the CollisionShape of new colliders and recompute it for those whose scale changed
+	void update_shapes();
 	void showDebugBox();
 	PhysicsSystem()
 	{
 	}
 
 private:
+	// Threads for integration and collision detection, large worlds are split into chunks across them
+	WorkerPool workers;
+
+	// v += a*dt; p += v*dt for every awake motion, vectorized over 'motion_arrays'
+	void integrate(float step_seconds);
+	MotionArrays motion_arrays;
+
+	// Dynamic bodies that kept their position with no velocity or acceleration for this many steps fall asleep
+	// Integrating them would not change them, so sleeping bodies are skipped until their Motion is inserted or
+	// accessed through get_mut, or an awake body touches them. Static bodies count as asleep from their second step.
+	static const unsigned int sleep_steps = 30;
+	struct SleepState
+	{
+		Entity entity;
+		BodyType type;
+		vec2 position; // at the start of the last step
+		unsigned int rest_steps;
+		bool asleep;
+		bool listed; // in 'awake_entities'
+		unsigned int passive_step; // last step it was a passive body of the broad phase
+	};
+	// Indexed by entity index
+	std::vector<SleepState> sleep_states;
+	// Bodies that are awake or were woken since the last step, sleeping ones leave the list
+	std::vector<Entity> awake_entities;
+	// Motions of the awake bodies that integrate moves
+	std::vector<Motion*> awake_motions;
+	unsigned int step_count = 0;
+
+	BodyType body_type(Entity entity);
+	SleepState& sleep_state(Entity entity);
+	// Put a body with a Motion back on the awake list
+	void wake(Entity entity);
+	// Wake the bodies whose components were written, count the resting steps of the awake ones and collect their motions
+	void update_sleep();
+	bool asleep(Entity entity) const;
+
+	// Place every attached entity at its offset from its parent, see Attachment
+	void resolve_attachments();
+	// (depth, index in registry.attachments) of every attachment, sorted, and the state of the container it is for
+	std::vector<std::pair<unsigned int, unsigned int>> attachment_order;
+	unsigned int attachment_version = ~0u;
+	unsigned int attachment_tick = ~0u;
+
+	// Tests the pairs of colliders found by 'broad_phase' and reports their contacts, 'precise' adds the mesh test
+	// Projectiles are swept over the step so that fast ones cannot pass through a target between two steps
+	void detect_collisions(bool precise, float step_seconds);
+	BroadPhase broad_phase;
+	// Every body in 'broad_phase'
+	std::vector<CollisionBody> bodies;
+	// Pair of bodies that passed the box tests, left for the mesh test and the contact cache
+	struct Hit
+	{
+		unsigned int i, j;
+		float time_of_impact;
+		bool swept;
+	};
+	// Hits of each chunk of candidate pairs, merged in chunk order
+	std::vector<std::vector<Hit>> chunk_hits;
+	// Mesh test for pairs of PreciseCollider entities
+	NarrowPhase narrow_phase;
+	// Pairs touching in the last step, turns the collisions into registry.contacts events
+	ContactCache contact_cache;
+
 	float xBorderLimitDist = 50;
 	float yBorderLimitDist = 50;
 	float playerBorderLimitDist = 25;
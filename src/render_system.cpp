@@ -211,12 +211,13 @@ void RenderSystem::drawDeathParticles(Entity entity, const mat3& projection)
 }
 
 void RenderSystem::drawTexturedMesh(Entity entity,
+									const Motion &motion,
+									const RenderRequest &render_request,
 									const mat3 &projection,
 								    GLint& frame,
 									GLfloat& frameWidth,
 									float elapsed_ms)
 {
-	Motion &motion = registry.motions.get(entity);
 	// Transformation code, see Rendering and Transformation in the template
 	// specification for more info Incrementally updates transformation matrix,
 	// thus ORDER IS IMPORTANT
@@ -226,9 +227,6 @@ void RenderSystem::drawTexturedMesh(Entity entity,
 	transform.scale(motion.scale);
 
 
-	assert(registry.renderRequests.has(entity));
-	const RenderRequest &render_request = registry.renderRequests.get(entity);
-
 	const GLuint used_effect_enum = (GLuint)render_request.used_effect;
 	assert(used_effect_enum != (GLuint)EFFECT_ASSET_ID::EFFECT_COUNT);
 	const GLuint program = (GLuint)effects[used_effect_enum];
@@ -278,9 +276,8 @@ void RenderSystem::drawTexturedMesh(Entity entity,
 		glActiveTexture(GL_TEXTURE0);
 		gl_has_errors();
 
-		assert(registry.renderRequests.has(entity));
 		GLuint texture_id =
-			texture_gl_handles[(GLuint)registry.renderRequests.get(entity).used_texture];
+			texture_gl_handles[(GLuint)render_request.used_texture];
 
 		glBindTexture(GL_TEXTURE_2D, texture_id);
 		gl_has_errors();
@@ -491,6 +488,39 @@ void RenderSystem::drawToScreen()
 	gl_has_errors();
 }
 
+void RenderSystem::save_previous_motions()
+{
+	for (PreviousMotion& previous : previous_motions)
+		previous.entity = Entity();
+	for (uint i = 0; i < registry.motions.size(); i++)
+	{
+		Entity e = registry.motions.entities[i];
+		if (e.index() >= previous_motions.size())
+			previous_motions.resize(e.index() + 1);
+		const Motion& motion = registry.motions.components[i];
+		previous_motions[e.index()] = { e, motion.position, motion.angle };
+	}
+}
+
+void RenderSystem::set_interpolation(float alpha)
+{
+	interpolation_alpha = clamp(alpha, 0.f, 1.f);
+}
+
+Motion RenderSystem::interpolated_motion(Entity e, const Motion& motion) const
+{
+	Motion result = motion;
+	if (e.index() >= previous_motions.size() || previous_motions[e.index()].entity != e)
+		return result;
+	const PreviousMotion& previous = previous_motions[e.index()];
+	result.position = mix(previous.position, motion.position, interpolation_alpha);
+	// Turn the short way round
+	float turn = motion.angle - previous.angle;
+	turn -= 2.f * M_PI * std::floor((turn + M_PI) / (2.f * M_PI));
+	result.angle = motion.angle - turn * (1.f - interpolation_alpha);
+	return result;
+}
+
 // Render our game world
 // http://www.opengl-tutorial.org/intermediate-tutorials/tutorial-14-render-to-texture/
 void RenderSystem::draw(float elapsed_ms)
@@ -526,7 +556,15 @@ void RenderSystem::draw(float elapsed_ms)
 	std::vector<Entity> dialogues;
 
 	mat3 projectionMat = createProjectionMatrix();
-	for (Entity entity : registry.renderRequests.entities) {
+
+	// drawLight();
+
+	// Draw all textured meshes that have a position and size component, in the order of the render requests
+	// UI buttons are drawn over them afterwards, see below
+	auto drawables = registry.view<RenderRequest, Motion>(exclude<UIButton>).use<RenderRequest>();
+	for (auto drawable : drawables)
+	{
+		Entity entity = std::get<0>(drawable);
 
 		// DISABLE CAMERA FOR NOW
 
@@ -546,26 +584,7 @@ void RenderSystem::draw(float elapsed_ms)
 		//	}
 		//	
 		//}
-		// Add only dialogue entities
-		if (registry.uiButtons.has(entity) && registry.uiButtons.get(entity).isDialogue) {
-			dialogues.push_back(entity);
-		}
-	}
-
-	// drawLight();
-
-	// Draw all textured meshes that have a position and size component
-	for (Entity entity : registry.renderRequests.entities)
-	{
-
-		// Skip the dialogue boxes to be rendered later
-		if (registry.uiButtons.has(entity) && registry.uiButtons.get(entity).isDialogue) {
-			continue;
-		}
-
 		mat3 projectionToUse = projectionMat;
-		if (!registry.motions.has(entity))
-			continue;
 
 		//if (registry.light.has(entity)) {
 		//	drawLight();	// only transparency effect??
@@ -1076,21 +1095,30 @@ void RenderSystem::draw(float elapsed_ms)
 
 			}
 			// UI-related entities should remain in constant position on screen
-			if (registry.buttons.has(entity) || registry.turnIndicators.has(entity) || registry.uiButtons.has(entity)) projectionToUse = projection_2D;
+			if (registry.buttons.has(entity) || registry.turnIndicators.has(entity)) projectionToUse = projection_2D;
 
-			if (registry.enemies.has(entity)) {
-				deferredRenderingEntities.emplace(registry.enemies.get(entity).healthbar, entity);
-			}
 			if (transitioningToNextLevel && registry.enemies.has(entity)) {
 				// delay rendering of enemies when transitioning to next level
 			} else if (transitioningToNextLevel && deferredRenderingEntities.count(entity) > 0) {
 				// delay rendering of enemy healthbar when transitioning to next level
 			} else {
-				drawTexturedMesh(entity, projectionToUse, curr_frame, frame_width, elapsed_ms);
+				drawTexturedMesh(entity, interpolated_motion(entity, std::get<2>(drawable)), std::get<1>(drawable), projectionToUse, curr_frame, frame_width, elapsed_ms);
 			}
 		}
 
 	}
+
+	// UI buttons stay in place on screen, the dialogue boxes are rendered after the screen effects
+	registry.view<UIButton, RenderRequest, Motion>().use<RenderRequest>().each([&](Entity entity, UIButton& button, RenderRequest& render_request, Motion& motion) {
+		if (button.isDialogue) {
+			dialogues.push_back(entity);
+			return;
+		}
+		GLint curr_frame = 0;
+		GLfloat frame_width = 0;
+		drawTexturedMesh(entity, interpolated_motion(entity, motion), render_request, projection_2D, curr_frame, frame_width, elapsed_ms);
+	});
+
 	// Truely render to the screen
 
 	drawToScreen();
@@ -1123,7 +1151,7 @@ void RenderSystem::draw(float elapsed_ms)
 	for (auto& entity : dialogues) {
 		GLint curr_frame = 0;
 		GLfloat frame_width = 0;
-		drawTexturedMesh(entity, projection_2D, curr_frame, frame_width, elapsed_ms);
+		drawTexturedMesh(entity, registry.motions.get(entity), registry.renderRequests.get(entity), projection_2D, curr_frame, frame_width, elapsed_ms);
 	}
 	
 	// flicker-free display with a double buffer
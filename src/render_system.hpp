@@ -29,8 +29,6 @@ class RenderSystem {
 		  std::pair<GEOMETRY_BUFFER_ID, std::string>(GEOMETRY_BUFFER_ID::SHIELD_MESH, mesh_path("necroBarrier.obj")),
 		  std::pair<GEOMETRY_BUFFER_ID, std::string>(GEOMETRY_BUFFER_ID::ROCK_MESH, mesh_path("rock.obj")),
 		  std::pair<GEOMETRY_BUFFER_ID, std::string>(GEOMETRY_BUFFER_ID::ARROW_MESH, mesh_path("arrow.obj")),
-		  std::pair<GEOMETRY_BUFFER_ID, std::string>(GEOMETRY_BUFFER_ID::SIMPLIFIED_ROCK_MESH, mesh_path("rock_simplified.obj")),
-		  std::pair<GEOMETRY_BUFFER_ID, std::string>(GEOMETRY_BUFFER_ID::SIMPLIFIED_ARROW_MESH, mesh_path("arrow_simplified.obj")),
 		  // specify meshes of other assets here
 	};
 
@@ -303,6 +301,8 @@ class RenderSystem {
 	std::array<GLuint, geometry_count> vertex_buffers;
 	std::array<GLuint, geometry_count> index_buffers;
 	std::array<Mesh, geometry_count> meshes;
+	// Collision shapes built from the meshes loaded from mesh_paths, see buildCollisionMesh
+	std::array<Mesh, geometry_count> collision_meshes;
 
 
 	// Time per frame in ms, for each action
@@ -461,6 +461,7 @@ public:
 	float nextLevelTranistionPeriod_ms = DEFAULT_GAME_LEVEL_TRANSITION_PERIOD_MS;
 	float dimScreenFactor = 0.4f;
 	float fogFactor = 0.2;
+	// Healthbar -> enemy, kept up to date by listeners on registry.enemies (see init)
 	std::map<int, int> deferredRenderingEntities = {};
 	std::vector<vec3> splineControlPoints;
 	int gameLevel = 1;
@@ -479,6 +480,7 @@ public:
 
 	void initializeGlMeshes();
 	Mesh& getMesh(GEOMETRY_BUFFER_ID id) { return meshes[(int)id]; };
+	Mesh& getCollisionMesh(GEOMETRY_BUFFER_ID id) { return collision_meshes[(int)id]; };
 
 	void initializeGlGeometryBuffers();
 	// Initialize the screen texture used as intermediate render target
@@ -492,6 +494,11 @@ public:
 	// Draw all entities
 	void draw(float elapsed_ms);
 
+	// Remember the motions before a simulation tick, drawing interpolates from them to the current ones
+	void save_previous_motions();
+	// Fraction of a tick the display is ahead of the last one, 0 draws the previous motions and 1 the current
+	void set_interpolation(float alpha);
+
 	mat3 createProjectionMatrix();
 
 	mat3 createCameraProjection(Motion& motion);
@@ -500,7 +507,7 @@ public:
 
 private:
 	// Internal drawing functions for each entity type
-	void drawTexturedMesh(Entity entity, const mat3& projection, GLint& frame, GLfloat& frameWidth, float elapsed_ms);
+	void drawTexturedMesh(Entity entity, const Motion& motion, const RenderRequest& render_request, const mat3& projection, GLint& frame, GLfloat& frameWidth, float elapsed_ms);
 	void drawDeathParticles(Entity entity, const mat3& projection);
 	// void initParticlesBuffer();
 	void drawToScreen();
@@ -519,9 +526,27 @@ private:
 
 	Entity screen_state_entity;
 
+	// Listeners on registry.enemies that maintain deferredRenderingEntities
+	unsigned int enemy_construct_listener = 0;
+	unsigned int enemy_update_listener = 0;
+	unsigned int enemy_destroy_listener = 0;
+
 	// GLuint particles_position_buffer;
 	float deformTime = 0.f;
 
+	// Motion of each entity before the last simulation tick, indexed by entity index
+	struct PreviousMotion
+	{
+		Entity entity;
+		vec2 position;
+		float angle;
+	};
+	std::vector<PreviousMotion> previous_motions;
+	float interpolation_alpha = 1.f;
+
+	// The motion of e at the interpolation point, or its current one when it did not exist before the tick
+	Motion interpolated_motion(Entity e, const Motion& motion) const;
+
 	//time 
 	float time = 0;
 };
@@ -8,6 +8,7 @@
 
 // This creates circular header inclusion, that is quite bad.
 #include "tiny_ecs_registry.hpp"
+#include "collision_mesh.hpp"
 
 // stlib
 #include <iostream>
@@ -62,6 +63,16 @@ bool RenderSystem::init(int width, int height, GLFWwindow* window_arg)
 	gl_has_errors();
 
 	initScreenTexture();
+
+	// Keep track of the enemy healthbars, they are held back with their enemy during level transitions
+	auto index_healthbar = [this](Entity entity, Enemy& enemy) {
+		deferredRenderingEntities[enemy.healthbar] = entity;
+	};
+	enemy_construct_listener = registry.enemies.on_construct().connect(index_healthbar);
+	enemy_update_listener = registry.enemies.on_update().connect(index_healthbar);
+	enemy_destroy_listener = registry.enemies.on_destroy().connect([this](Entity entity, Enemy& enemy) {
+		deferredRenderingEntities.erase(enemy.healthbar);
+	});
     initializeGlTextures();
 	initializeGlEffects();
 	initializeGlGeometryBuffers();
@@ -146,6 +157,9 @@ void RenderSystem::initializeGlMeshes()
 		bindVBOandIBO(geom_index,
 			meshes[(int)geom_index].vertices, 
 			meshes[(int)geom_index].vertex_indices);
+
+		// Convex and vertex capped stand-in for the mesh tests of the physics
+		buildCollisionMesh(meshes[(int)geom_index], collision_meshes[(int)geom_index], collisionMeshCachePath(name));
 	}
 }
 
@@ -644,12 +658,17 @@ RenderSystem::~RenderSystem()
 
 	// remove all entities created by the render system
 	while (registry.renderRequests.entities.size() > 0)
-	    registry.remove_all_components_of(registry.renderRequests.entities.back());
+	    registry.destroy(registry.renderRequests.entities.back());
+
+	registry.enemies.on_construct().disconnect(enemy_construct_listener);
+	registry.enemies.on_update().disconnect(enemy_update_listener);
+	registry.enemies.on_destroy().disconnect(enemy_destroy_listener);
 }
 
 // Initialize the screen texture from a standard sprite
 bool RenderSystem::initScreenTexture()
 {
+	screen_state_entity = registry.create();
 	registry.screenStates.emplace(screen_state_entity);
 
 	int width, height;
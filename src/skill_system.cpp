@@ -234,7 +234,7 @@ void SkillSystem::startMeleeAttack(Entity origin, Entity target, int bleedOrAOE)
 		Enemy& enemy = registry.enemies.get(origin);
 		enemy.curr_anim_type = WALKING;
 
-		Motion& enemy_motion = registry.motions.get(origin);
+		Motion& enemy_motion = registry.motions.get_mut(origin);
 		Motion target_motion = registry.motions.get(target);
 
 		// Add enemy to the running component
@@ -254,8 +254,6 @@ void SkillSystem::startMeleeAttack(Entity origin, Entity target, int bleedOrAOE)
 		float speed = 550.f;
 
 		enemy_motion.velocity = { -speed,0.f };
-		Motion& healthBar = registry.motions.get(enemy.healthbar);
-		healthBar.velocity = enemy_motion.velocity;
 
 		// Calculate the timer
 		float time = (enemy_motion.position.x - rt.target_position.x) / speed;
@@ -287,7 +285,7 @@ void SkillSystem::startMeleeAttack(Entity origin, Entity target, int bleedOrAOE)
 		Companion& companion = registry.companions.get(origin);
 		companion.curr_anim_type = WALKING;
 
-		Motion& companion_motion = registry.motions.get(origin);
+		Motion& companion_motion = registry.motions.get_mut(origin);
 		Motion target_motion = registry.motions.get(target);
 
 		// Add enemy to the running component
@@ -307,8 +305,6 @@ void SkillSystem::startMeleeAttack(Entity origin, Entity target, int bleedOrAOE)
 		float speed = 550.f;
 
 		companion_motion.velocity = { speed,0.f };
-		Motion& healthBar = registry.motions.get(companion.healthbar);
-		healthBar.velocity = companion_motion.velocity;
 
 		// Calculate the timer
 		float time = (rt.target_position.x - companion_motion.position.x) / speed;
@@ -459,7 +455,7 @@ Entity SkillSystem::launchIceShard(vec2 startPos, vec2 ms_pos, RenderSystem* ren
 	}
 
 	Entity resultEntity = createIceShard(renderer, { startPos.x + 50, startPos.y }, angle, { vx,vy }, 1);
-	Motion* ballacc = &registry.motions.get(resultEntity);
+	Motion* ballacc = &registry.motions.get_mut(resultEntity);
 	ballacc->acceleration = vec2(1000 * vx / ICESHARDSPEED, 1000 * vy / ICESHARDSPEED);
 	Projectile* proj = &registry.projectiles.get(resultEntity);
 	proj->flyingTimer = 2000.f;
@@ -477,7 +473,7 @@ void SkillSystem::launchHeal(Entity target, float amount,  RenderSystem* rendere
 
 	createGreenCross(renderer, targetp);
 	if (registry.stats.has(target)) {
-		Statistics* tStats = &registry.stats.get(target);
+		Statistics* tStats = &registry.stats.get_mut(target);
 		if (tStats->health + amount > tStats->max_health) {
 			tStats->health = tStats->max_health;
 		}
@@ -509,7 +505,7 @@ void SkillSystem::luanchCompanionTeamHeal( float amount, RenderSystem* renderer)
 		vec2 targetp = registry.motions.get(cp).position;
 		createGreenCross(renderer, targetp);
 		if (registry.stats.has(cp)) {
-			Statistics* tStats = &registry.stats.get(cp);
+			Statistics* tStats = &registry.stats.get_mut(cp);
 			if (tStats->health + amount > tStats->max_health) {
 				tStats->health = tStats->max_health;
 			}
@@ -528,7 +524,7 @@ void SkillSystem::luanchEnemyTeamDamage(float amount, RenderSystem* renderer) {
 		createMeteorShower(renderer, { 1400, 0  }, 0);
 		Mix_PlayChannel(-1, registry.gesture_aoe_sound, 0);
 		if (registry.stats.has(em)) {
-			Statistics* tStats = &registry.stats.get(em);
+			Statistics* tStats = &registry.stats.get_mut(em);
 				tStats->health -= amount;
 		}
 	}
@@ -564,7 +560,7 @@ Entity SkillSystem::launchFireball(vec2 startPos, vec2 ms_pos, RenderSystem* ren
 		angle += M_PI;
 	}
 	Entity resultEntity = createFireBall(renderer, { startPos.x + 50, startPos.y }, angle, { vx,vy }, 1);
-	Motion* arrowacc = &registry.motions.get(resultEntity);
+	Motion* arrowacc = &registry.motions.get_mut(resultEntity);
 	arrowacc->acceleration = vec2(200 * vx / fireball_speed_x, 200 * vy / fireball_speed_y);
 
 	return  resultEntity;
@@ -590,7 +586,7 @@ Entity SkillSystem::launchArrow(Entity start, vec2 ms_pos, RenderSystem* rendere
 		angle += M_PI;
 	}
 	Entity resultEntity = createArrow(renderer, { startPos.x, startPos.y }, angle, { vx,vy }, 1, isFreeRoam);
-	Motion* arrowacc = &registry.motions.get(resultEntity);
+	Motion* arrowacc = &registry.motions.get_mut(resultEntity);
 	arrowacc->acceleration = vec2(200 * vx / ARROWSPEED, 200 * vy / ARROWSPEED);
 
 	return  resultEntity;
@@ -667,7 +663,7 @@ void SkillSystem::removeTaunt(Entity target) {
 		registry.taunts.remove(target);
 		for (int j = 0; j < registry.statsindicators.components.size(); j++) {
 			if (registry.statsindicators.components[j].owner == target) {
-				registry.remove_all_components_of(registry.statsindicators.entities[j]);
+				registry.destroy(registry.statsindicators.entities[j]);
 			}
 		}
 		printf("taunt removed!!!!!!!!!!!!!!!!!!!!!!!\n");
@@ -679,7 +675,7 @@ void SkillSystem::removeBleed(Entity target) {
 		registry.bleeds.remove(target);
 		for (int j = 0; j < registry.bleedIndicators.components.size(); j++) {
 			if (registry.bleedIndicators.components[j].owner == target) {
-				registry.remove_all_components_of(registry.bleedIndicators.entities[j]);
+				registry.destroy(registry.bleedIndicators.entities[j]);
 			}
 		}
 		printf("bleed removed!!!!!!!!!!!!!!!!!!!!!!!\n");
@@ -742,7 +738,7 @@ void SkillSystem::launchParticleBeam(Entity target) {
 	for (int i = 0; i < registry.ultimate.components.size(); i++) {
 		Entity e = registry.ultimate.entities[i];
 		if (registry.motions.get(e).scale.x == PARTICLEBEAMCHARGE_WIDTH) {
-			registry.remove_all_components_of(e);
+			registry.destroy(e);
 		}
 	}
 	if (!registry.ultimate.has(target)) {
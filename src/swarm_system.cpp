@@ -72,12 +72,12 @@ void SwarmSystem::updateSwarm() {
 
 	for (int i = 0; i < NUM_SWARM_PARTICLES; i++) {
 		if (!registry.motions.has(fireflyEntities[i])) continue;
-		Motion& particleMotion = registry.motions.get(fireflyEntities[i]);
+		Motion& particleMotion = registry.motions.get_mut(fireflyEntities[i]);
 
 		// Check if any two fireflies are too close to each other
 		for (int j = 0; j < NUM_SWARM_PARTICLES; j++) {
 			if (!registry.motions.has(fireflyEntities[j])) continue;
-			Motion& otherParticleMotion = registry.motions.get(fireflyEntities[j]);
+			Motion& otherParticleMotion = registry.motions.get_mut(fireflyEntities[j]);
 
 			// x-pos is too close
 			if (particleMotion.position.x < otherParticleMotion.position.x && particleMotion.position.x > otherParticleMotion.position.x - SEPARATION_DIST) {
@@ -139,7 +139,7 @@ void SwarmSystem::updateSwarm() {
 
 		for (int i = 0; i < NUM_SWARM_PARTICLES; i++) {
 			if (!registry.motions.has(fireflyEntities[i]) || registry.fireflySwarm.components[i].isDodging) continue;
-			Motion& particleMotion = registry.motions.get(fireflyEntities[i]);
+			Motion& particleMotion = registry.motions.get_mut(fireflyEntities[i]);
 
 			// Particle is closer to the left edge than center, move right
 			if (abs(particleMotion.position.x - midpointX) >= abs(particleMotion.position.x - minX)) {
@@ -161,7 +161,7 @@ void SwarmSystem::updateSwarm() {
 
 		for (int i = 0; i < NUM_SWARM_PARTICLES; i++) {
 			if (!registry.motions.has(fireflyEntities[i]) || registry.fireflySwarm.components[i].isDodging) continue;
-			Motion& particleMotion = registry.motions.get(fireflyEntities[i]);
+			Motion& particleMotion = registry.motions.get_mut(fireflyEntities[i]);
 
 			// Particle is closer to the top edge than center, move down
 			if (abs(particleMotion.position.y - midpointY) >= abs(particleMotion.position.y - minY)) {
@@ -1,5 +1,7 @@
 // internal
 #include "tiny_ecs.hpp"
 
-// All we need to store besides the containers is the id of every entity and callbacks to be able to remove entities across containers
-unsigned int Entity::id_count = 1;
\ No newline at end of file
+// Entity ids are handed out by the registry, only the layout of the packed id lives here
+const unsigned int Entity::index_bits;
+const unsigned int Entity::index_mask;
+const unsigned int Entity::generation_mask;
\ No newline at end of file
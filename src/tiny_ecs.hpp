@@ -2,43 +2,276 @@
 
 #include <algorithm>
 #include <vector>
+#include <tuple>
 #include <unordered_map>
 #include <set>
 #include <functional>
 #include <typeindex>
+#include <bitset>
+#include <string>
+#include <typeinfo>
 #include <assert.h>
 
+// Containers count their has/get/insert/remove calls when ECS_TELEMETRY is 1, which is the default in debug builds
+#ifndef ECS_TELEMETRY
+#ifdef NDEBUG
+#define ECS_TELEMETRY 0
+#else
+#define ECS_TELEMETRY 1
+#endif
+#endif
+
 // Unique identifyer for all entities
+// The id packs an index (low bits) and a generation (high bits). Indices are handed out and recycled by
+// the registry (see ECSRegistry::create/destroy), the generation is bumped on every re-use so that old
+// handles to a destroyed entity can be told apart from the new owner of the index.
 class Entity
 {
 	unsigned int id;
-	static unsigned int id_count; // starts from 1, entit 0 is the default initialization
 public:
-	Entity()
+	static const unsigned int index_bits = 20;
+	static const unsigned int index_mask = (1u << index_bits) - 1;
+	static const unsigned int generation_mask = (1u << (32 - index_bits)) - 1;
+
+	// The default entity is the null handle (index 0), it never owns components
+	Entity() : id(0)
 	{
-		id = id_count++;
-		// Note, indices of already deleted entities arent re-used in this simple implementation.
 	}
-	operator unsigned int() { return id; } // this enables automatic casting to int
+	Entity(unsigned int index, unsigned int generation) : id(((generation & generation_mask) << index_bits) | (index & index_mask))
+	{
+	}
+	unsigned int index() const { return id & index_mask; }
+	unsigned int generation() const { return id >> index_bits; }
+	operator unsigned int() const { return id; } // this enables automatic casting to int
+};
+
+// Set of component types an entity owns, bit i stands for the component with id i (see ECSRegistry::component_id)
+static const unsigned int max_component_types = 64;
+typedef std::bitset<max_component_types> Signature;
+
+// A compile-time list of types, the registry stores one container per entry
+template <typename... Types>
+struct TypeList {};
+
+// Position of 'T' in a TypeList, this is the compile-time id of a component type
+template <typename T, typename List>
+struct TypeIndex;
+template <typename T, typename... Rest>
+struct TypeIndex<T, TypeList<T, Rest...>>
+{
+	static constexpr unsigned int value = 0;
+};
+template <typename T, typename First, typename... Rest>
+struct TypeIndex<T, TypeList<First, Rest...>>
+{
+	static constexpr unsigned int value = 1 + TypeIndex<T, TypeList<Rest...>>::value;
+};
+template <typename T>
+struct TypeIndex<T, TypeList<>>
+{
+	static_assert(sizeof(T) == 0, "Component type is not part of the registry's ComponentTypes list");
+};
+
+// Memory footprint and access counts of one container, see ComponentContainer::telemetry
+struct ContainerTelemetry
+{
+	std::string type; // name of the component type, see ContainerInterface::type_name
+	size_t count = 0;
+	size_t capacity = 0;
+	// Allocated bytes of the dense arrays (components, and entities with their change ticks) and of the sparse pages
+	size_t component_bytes = 0;
+	size_t entity_bytes = 0;
+	size_t index_bytes = 0;
+	size_t index_pages = 0;
+	// Fraction of the allocated sparse slots that are in use, the closer to 1 the less the index wastes
+	float index_occupancy = 0.f;
+	// Components inserted with duplicates allowed that the sparse index no longer points at
+	size_t shadowed = 0;
+	// Calls since the last reset_counters, always 0 if ECS_TELEMETRY is off
+	unsigned int has_calls = 0;
+	unsigned int get_calls = 0;
+	unsigned int insert_calls = 0;
+	unsigned int remove_calls = 0;
 };
 
 // Common interface to refer to all containers in the ECS registry
 struct ContainerInterface
 {
+	virtual ContainerTelemetry telemetry() const = 0;
+	virtual void reset_counters() = 0;
+	virtual void reserve(size_t n) = 0;
+	virtual size_t capacity() const = 0;
+	// Name the registry gave the component type, the same with every compiler
+	virtual const char* type_name() const = 0;
 	virtual void clear() = 0;
-	virtual size_t size() = 0;
+	virtual size_t size() const = 0;
 	virtual void remove(Entity e) = 0;
+	virtual void remove_batch(std::vector<Entity>& batch) = 0;
 	virtual bool has(Entity entity) = 0;
 };
 
+// Callbacks for one kind of component event (see ComponentContainer::on_construct, on_destroy, on_update)
+// Listeners are called with the entity and its component; they must not add or remove components of the same
+// type, nor connect or disconnect listeners of this sink, while being called.
+template <typename Component>
+class Sink
+{
+	std::vector<std::pair<unsigned int, std::function<void(Entity, Component&)>>> listeners;
+	unsigned int last_id = 0;
+
+public:
+	// Register func, the returned id can be passed to disconnect
+	unsigned int connect(std::function<void(Entity, Component&)> func)
+	{
+		listeners.emplace_back(++last_id, std::move(func));
+		return last_id;
+	}
+
+	void disconnect(unsigned int id)
+	{
+		listeners.erase(std::remove_if(listeners.begin(), listeners.end(),
+			[id](const std::pair<unsigned int, std::function<void(Entity, Component&)>>& l) { return l.first == id; }), listeners.end());
+	}
+
+	bool empty() const
+	{
+		return listeners.empty();
+	}
+
+	void publish(Entity e, Component& c) const
+	{
+		for (const auto& l : listeners)
+			l.second(e, c);
+	}
+};
+
 // A container that stores components of type 'Component' and associated entities
+// The lookup from Entity -> array index is a paged sparse set: the entity id selects a page and a slot
+// in that page, which holds the position of the component in the dense 'components' and 'entities' arrays.
+// has/get/remove are therefore plain array reads, no hashing involved.
 template <typename Component> // A component can be any class
 class ComponentContainer : public ContainerInterface
 {
 private:
-	// The hash map from Entity -> array index.
-	std::unordered_map<unsigned int, unsigned int> map_entity_componentID; // the entity is cast to uint to be hashable.
+	// Number of entity slots per sparse page, pages are only allocated once an entity id in their range is used
+	static const unsigned int page_size = 4096;
+	static const unsigned int invalid_index = ~0u;
+
+	// The sparse array from Entity -> array index, split into pages to keep it compact for large ids
+	std::vector<std::vector<unsigned int>> sparse_pages;
 	bool registered = false;
+
+	// Signatures of the owning registry (indexed by entity index) and the bit of this container in them
+	std::vector<Signature>* signatures = nullptr;
+	unsigned int component_id = 0;
+	const char* name = "";
+
+	// Bumped whenever components are added, removed or re-ordered, see structure_version
+	unsigned int version = 0;
+
+	// Change tracking: 'tick' counts modifications of this container, changed_at[i] is the tick at which
+	// components[i] was last inserted or accessed through get_mut/patch
+	unsigned int tick = 0;
+	std::vector<unsigned int> changed_at;
+
+	// Entities inserted or accessed through get_mut since 'drained_tick', only kept after track_changes
+	bool log_changes = false;
+	unsigned int drained_tick = 0;
+	std::vector<Entity> change_log;
+
+	// Listeners, only consulted when not empty
+	Sink<Component> construct_sink, destroy_sink, update_sink;
+
+	// Access counters reported by telemetry
+	unsigned int has_calls = 0, get_calls = 0, insert_calls = 0, remove_calls = 0;
+
+	void set_signature_bit(Entity e, bool value)
+	{
+		if (signatures == nullptr)
+			return;
+		if (e.index() >= signatures->size())
+			signatures->resize(e.index() + 1);
+		(*signatures)[e.index()].set(component_id, value);
+	}
+
+	// Remove the component at dense position cID by moving the last one into its place
+	void remove_at(unsigned int cID)
+	{
+		Entity e = entities[cID];
+		if (!destroy_sink.empty())
+			destroy_sink.publish(e, components[cID]);
+
+		// Move the last element to position cID using the move operator
+		// Note, components[cID] = components.back() would trigger the copy instead of move operator
+		components[cID] = std::move(components.back());
+		entities[cID] = entities.back(); // the entity is only a single index, copy it.
+		changed_at[cID] = changed_at.back();
+		sparse_slot(entities[cID]) = cID;
+
+		// Erase the old component and free its memory
+		sparse_slot(e) = invalid_index;
+		set_signature_bit(e, false);
+		components.pop_back();
+		entities.pop_back();
+		changed_at.pop_back();
+		version++;
+	}
+
+	// Move the components to match a new order of 'entities', in place
+	// The sparse array still holds the old positions, the permutation is applied cycle by cycle so that every
+	// component is moved exactly once and no second array is needed.
+	void apply_entity_order()
+	{
+		for (unsigned int i = 0; i < entities.size(); i++)
+		{
+			if (sparse_slot(entities[i]) == i)
+				continue;
+			Component first = std::move(components[i]);
+			unsigned int first_changed = changed_at[i];
+			unsigned int cur = i;
+			while (true)
+			{
+				unsigned int& slot = sparse_slot(entities[cur]);
+				unsigned int next = slot; // old position of the component that belongs at cur
+				slot = cur;
+				if (next == i)
+				{
+					components[cur] = std::move(first);
+					changed_at[cur] = first_changed;
+					break;
+				}
+				components[cur] = std::move(components[next]);
+				changed_at[cur] = changed_at[next];
+				cur = next;
+			}
+		}
+		version++;
+	}
+
+	// Returns the slot of the sparse array that belongs to 'e', allocating the page if needed
+	unsigned int& sparse_slot(Entity e)
+	{
+		unsigned int page = e.index() / page_size;
+		if (page >= sparse_pages.size())
+			sparse_pages.resize(page + 1);
+		if (sparse_pages[page].empty())
+			sparse_pages[page].assign(page_size, invalid_index);
+		return sparse_pages[page][e.index() % page_size];
+	}
+
+	// Returns the dense index of 'e' or invalid_index if the entity has no component of this type
+	// The slot is shared by all generations of an index, so the stored entity is compared to reject stale handles
+	unsigned int dense_index(Entity e) const
+	{
+		unsigned int page = e.index() / page_size;
+		if (page >= sparse_pages.size() || sparse_pages[page].empty())
+			return invalid_index;
+		unsigned int cID = sparse_pages[page][e.index() % page_size];
+		if (cID == invalid_index || entities[cID] != e)
+			return invalid_index;
+		return cID;
+	}
+
 public:
 	// Container of all components of type 'Component'
 	std::vector<Component> components;
@@ -51,16 +284,36 @@ public:
 	{
 	}
 
+	// Called by the registry to have this container keep the entity signatures up to date
+	void attach(std::vector<Signature>* registry_signatures, unsigned int id, const char* type)
+	{
+		assert(id < max_component_types && "Too many component types for the Signature bitset");
+		signatures = registry_signatures;
+		component_id = id;
+		name = type;
+	}
+
 	// Inserting a component c associated to entity e
 	inline Component& insert(Entity e, Component c, bool check_for_duplicates = true)
 	{
 		// Usually, every entity should only have one instance of each component type
-		assert(!(check_for_duplicates && has(e)) && "Entity already contained in ECS registry");
+		assert(!(check_for_duplicates && dense_index(e) != invalid_index) && "Entity already contained in ECS registry");
 
-		map_entity_componentID[e] = (unsigned int)components.size();
+#if ECS_TELEMETRY
+		insert_calls++;
+#endif
+		unsigned int cID = (unsigned int)components.size();
+		sparse_slot(e) = cID;
+		set_signature_bit(e, true);
 		components.push_back(std::move(c)); // the move enforces move instead of copy constructor
 		entities.push_back(e);
-		return components.back();
+		changed_at.push_back(++tick);
+		if (log_changes)
+			change_log.push_back(e);
+		version++;
+		if (!construct_sink.empty())
+			construct_sink.publish(e, components[cID]);
+		return components[cID];
 	};
 
 	// The emplace function takes the the provided arguments Args, creates a new object of type Component, and inserts it into the ECS system
@@ -75,63 +328,319 @@ public:
 
 	// A wrapper to return the component of an entity
 	Component& get(Entity e) {
-		assert(has(e) && "Entity not contained in ECS registry");
-		return components[map_entity_componentID[e]];
+		assert(dense_index(e) != invalid_index && "Entity not contained in ECS registry");
+#if ECS_TELEMETRY
+		get_calls++;
+#endif
+		return components[dense_index(e)];
+	}
+
+	// Like get, but marks the component as changed (see changed_since), use it when modifying the component
+	Component& get_mut(Entity e) {
+		assert(dense_index(e) != invalid_index && "Entity not contained in ECS registry");
+#if ECS_TELEMETRY
+		get_calls++;
+#endif
+		unsigned int cID = dense_index(e);
+		// A component changed since the last drain is in the log already
+		if (log_changes && changed_at[cID] <= drained_tick)
+			change_log.push_back(e);
+		changed_at[cID] = ++tick;
+		return components[cID];
+	}
+
+	// Modify the component of e through func(Component&), mark it as changed and notify the on_update listeners
+	template <typename Func>
+	void patch(Entity e, Func func) {
+		Component& c = get_mut(e);
+		func(c);
+		if (!update_sink.empty())
+			update_sink.publish(e, c);
+	}
+
+	// Listeners called after a component was inserted, before one is removed (also by clear), and after patch
+	Sink<Component>& on_construct() { return construct_sink; }
+	Sink<Component>& on_destroy() { return destroy_sink; }
+	Sink<Component>& on_update() { return update_sink; }
+
+	// The current change tick, store it to later ask for the changes made since then
+	unsigned int current_tick() const {
+		return tick;
+	}
+
+	// Check if the component of e was inserted or modified after 'since' (a value of current_tick)
+	bool changed_since(Entity e, unsigned int since) const {
+		unsigned int cID = dense_index(e);
+		return cID != invalid_index && changed_at[cID] > since;
+	}
+
+	// Calls func(Entity, Component&) for every component inserted or modified after 'since'
+	template <typename Func>
+	void each_changed(unsigned int since, Func func) {
+		if (tick == since)
+			return;
+		for (unsigned int i = 0; i < components.size(); i++)
+			if (changed_at[i] > since)
+				func(entities[i], components[i]);
+	}
+
+	// Start logging the inserted and modified entities for drain_changes, the current ones are logged as changed
+	void track_changes() {
+		if (log_changes)
+			return;
+		log_changes = true;
+		change_log.assign(entities.begin(), entities.end());
+		drained_tick = tick;
+	}
+
+	// Calls func(Entity) for the entities that were inserted or accessed through get_mut/patch since the last drain
+	// and still have a component, then empties the log. Unlike each_changed it does not scan the container, but an
+	// entity may be passed more than once. Requires track_changes, func must not modify this container.
+	template <typename Func>
+	void drain_changes(Func func) {
+		assert(log_changes && "Call track_changes before draining changes");
+		for (Entity e : change_log)
+			if (dense_index(e) != invalid_index)
+				func(e);
+		change_log.clear();
+		drained_tick = tick;
 	}
 
 	// Check if entity has a component of type 'Component'
 	bool has(Entity entity) {
-		return map_entity_componentID.count(entity) > 0;
+#if ECS_TELEMETRY
+		has_calls++;
+#endif
+		return dense_index(entity) != invalid_index;
 	}
 
 	// Remove an component and pack the container to re-use the empty space
 	void remove(Entity e)
 	{
-		if (has(e))
+#if ECS_TELEMETRY
+		remove_calls++;
+#endif
+		unsigned int cID = dense_index(e);
+		if (cID != invalid_index)
+			remove_at(cID);
+	};
+
+	// Remove the components of all entities in 'batch' at once, entities without one are skipped
+	// The positions are visited from the back to the front, so every element that fills a hole is a survivor
+	// and the container is compacted in a single pass over the removed positions.
+	void remove_batch(std::vector<Entity>& batch)
+	{
+#if ECS_TELEMETRY
+		remove_calls += (unsigned int)batch.size();
+#endif
+		std::vector<unsigned int> cIDs;
+		cIDs.reserve(batch.size());
+		for (Entity e : batch)
 		{
-			// Get the current position
-			int cID = map_entity_componentID[e];
-
-			// Move the last element to position cID using the move operator
-			// Note, components[cID] = components.back() would trigger the copy instead of move operator
-			components[cID] = std::move(components.back());
-			entities[cID] = entities.back(); // the entity is only a single index, copy it.
-			map_entity_componentID[entities.back()] = cID;
-
-			// Erase the old component and free its memory
-			map_entity_componentID.erase(e);
-			components.pop_back();
-			entities.pop_back();
-			// Note, one could mark the id for re-use
+			unsigned int cID = dense_index(e);
+			if (cID != invalid_index)
+				cIDs.push_back(cID);
 		}
-	};
+		std::sort(cIDs.begin(), cIDs.end(), std::greater<unsigned int>());
+		cIDs.erase(std::unique(cIDs.begin(), cIDs.end()), cIDs.end());
+		for (unsigned int cID : cIDs)
+			remove_at(cID);
+	}
+
+	// Make room for 'n' components without re-allocating
+	void reserve(size_t n)
+	{
+		components.reserve(n);
+		entities.reserve(n);
+		changed_at.reserve(n);
+	}
 
 	// Remove all components of type 'Component'
 	void clear()
 	{
-		map_entity_componentID.clear();
+		if (!destroy_sink.empty())
+			for (unsigned int i = 0; i < entities.size(); i++)
+				destroy_sink.publish(entities[i], components[i]);
+
+		// Only reset the slots that are in use, the pages themselves are kept for re-use
+		for (Entity& e : entities)
+		{
+			sparse_slot(e) = invalid_index;
+			set_signature_bit(e, false);
+		}
 		components.clear();
 		entities.clear();
+		changed_at.clear();
+		version++;
 	}
 
 	// Report the number of components of type 'Component'
-	size_t size()
+	size_t size() const
 	{
 		return components.size();
 	}
 
+	// Number of components that fit without re-allocating
+	size_t capacity() const
+	{
+		return components.capacity();
+	}
+
+	const char* type_name() const
+	{
+		return name;
+	}
+
+	// Report the memory use and access counts of this container
+	ContainerTelemetry telemetry() const
+	{
+		ContainerTelemetry t;
+		t.type = type_name();
+		t.count = components.size();
+		t.capacity = components.capacity();
+		t.component_bytes = components.capacity() * sizeof(Component);
+		t.entity_bytes = entities.capacity() * sizeof(Entity) + changed_at.capacity() * sizeof(unsigned int)
+			+ change_log.capacity() * sizeof(Entity);
+		t.index_bytes = sparse_pages.capacity() * sizeof(std::vector<unsigned int>);
+		for (const auto& page : sparse_pages)
+		{
+			if (page.empty())
+				continue;
+			t.index_pages++;
+			t.index_bytes += page.capacity() * sizeof(unsigned int);
+		}
+		if (t.index_pages > 0)
+		{
+			size_t indexed = 0;
+			for (unsigned int i = 0; i < entities.size(); i++)
+				if (dense_index(entities[i]) == i)
+					indexed++;
+			t.shadowed = t.count - indexed;
+			t.index_occupancy = (float)indexed / (float)(t.index_pages * page_size);
+		}
+		t.has_calls = has_calls;
+		t.get_calls = get_calls;
+		t.insert_calls = insert_calls;
+		t.remove_calls = remove_calls;
+		return t;
+	}
+
+	// Start counting accesses from zero
+	void reset_counters()
+	{
+		has_calls = get_calls = insert_calls = remove_calls = 0;
+	}
+
 	// Sort the components and associated entity assignment structures by the comparisonFunction, see std::sort
+	// The entities are sorted first and the components are then permuted in place to follow them
 	template <class Compare>
 	void sort(Compare comparisonFunction)
 	{
-		// First sort the entity list as desired
 		std::sort(entities.begin(), entities.end(), comparisonFunction);
-		// Now re-arrange the components (Note, creates a new vector, which may be slow! Not sure if in-place could be faster: https://stackoverflow.com/questions/63703637/how-to-efficiently-permute-an-array-in-place-using-stdswap)
-		std::vector<Component> components_new; components_new.reserve(components.size());
-		std::transform(entities.begin(), entities.end(), std::back_inserter(components_new), [&](Entity e) { return std::move(get(e)); }); // note, the get still uses the old hash map (on purpose!)
-		components = std::move(components_new); // note, we use move operations to not create unneccesary copies of objects, but memory is still allocated for the new vector
-		// Fill the new hashmap
-		for (unsigned int i = 0; i < entities.size(); i++)
-			map_entity_componentID[entities[i]] = i;
+		apply_entity_order();
+	}
+
+	// Changes whenever the set or order of entities changes, but not when components are only modified
+	unsigned int structure_version() const
+	{
+		return version;
+	}
+};
+
+template <typename Component>
+const unsigned int ComponentContainer<Component>::page_size;
+template <typename Component>
+const unsigned int ComponentContainer<Component>::invalid_index;
+
+// Tag listing component types that entities of a view must not have, e.g. registry.view<Motion>(exclude<UIButton>)
+template <typename... Component>
+struct exclude_t {};
+template <typename... Component>
+constexpr exclude_t<Component...> exclude{};
+
+// A view over all entities that have every 'Component' and none of the 'Excluded' components
+// It walks the entities of the smallest included container (or the one picked with use) and tests the others with
+// a signature mask, so the cost is bounded by the rarest component. Iterating yields (Entity, Component&...) tuples,
+// each() passes them as arguments. Components of the viewed types must not be added or removed while iterating.
+template <typename Include, typename Exclude>
+class View;
+
+template <typename... Component, typename... Excluded>
+class View<std::tuple<Component...>, std::tuple<Excluded...>>
+{
+	static_assert(sizeof...(Component) > 0, "A view needs at least one component type");
+
+	std::tuple<ComponentContainer<Component>*...> pools;
+	std::vector<Entity>* driver;
+
+	// The registry's signatures, membership is a single mask test
+	const std::vector<Signature>* signatures;
+	Signature include_mask, exclude_mask;
+
+	bool contains(Entity e) const
+	{
+		// Entities of the driving container are live, so their signature slot exists
+		const Signature& s = (*signatures)[e.index()];
+		return (s & include_mask) == include_mask && (s & exclude_mask).none();
+	}
+
+public:
+	View(std::tuple<ComponentContainer<Component>*...> include_pools, const std::vector<Signature>* registry_signatures,
+		Signature include_bits, Signature exclude_bits)
+		: pools(include_pools), signatures(registry_signatures), include_mask(include_bits), exclude_mask(exclude_bits)
+	{
+		// Drive the iteration with the container that has the fewest entities
+		driver = &std::get<0>(pools)->entities;
+		using expand = int[];
+		(void)expand{ 0, (std::get<ComponentContainer<Component>*>(pools)->entities.size() < driver->size()
+			? (driver = &std::get<ComponentContainer<Component>*>(pools)->entities, 0) : 0)... };
+	}
+
+	// Iterate in the order of the 'Driver' container instead of the smallest one, e.g. to keep a draw order
+	template <typename Driver>
+	View& use()
+	{
+		driver = &std::get<ComponentContainer<Driver>*>(pools)->entities;
+		return *this;
+	}
+
+	class iterator
+	{
+		const View* view;
+		size_t pos;
+
+		// Advance to the next entity of the driving container that belongs to the view
+		void skip()
+		{
+			while (pos < view->driver->size() && !view->contains((*view->driver)[pos]))
+				pos++;
+		}
+	public:
+		iterator(const View* v, size_t p) : view(v), pos(p) { skip(); }
+		iterator& operator++() { pos++; skip(); return *this; }
+		bool operator!=(const iterator& other) const { return pos < other.pos && pos < view->driver->size(); }
+		std::tuple<Entity, Component&...> operator*() const
+		{
+			Entity e = (*view->driver)[pos];
+			return std::tuple<Entity, Component&...>(e, std::get<ComponentContainer<Component>*>(view->pools)->get(e)...);
+		}
+	};
+
+	iterator begin() const { return iterator(this, 0); }
+	iterator end() const { return iterator(this, driver->size()); }
+
+	// Upper bound on the number of entities in the view
+	size_t size_hint() const { return driver->size(); }
+
+	// Calls func(Entity, Component&...) for every entity in the view
+	template <typename Func>
+	void each(Func func) const
+	{
+		for (size_t i = 0; i < driver->size(); i++)
+		{
+			Entity e = (*driver)[i];
+			if (contains(e))
+				func(e, std::get<ComponentContainer<Component>*>(pools)->get(e)...);
+		}
 	}
 };
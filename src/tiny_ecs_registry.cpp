@@ -1,3 +1,42 @@
 #include "tiny_ecs_registry.hpp"
+#include "../ext/nlohmann/json.hpp"
 
-ECSRegistry registry;
\ No newline at end of file
+ECSRegistry registry;
+
+std::string ECSRegistry::telemetry_json() const
+{
+	nlohmann::json pools = nlohmann::json::array();
+	size_t total_bytes = 0;
+	for (const ContainerTelemetry& t : telemetry())
+	{
+		size_t bytes = t.component_bytes + t.entity_bytes + t.index_bytes;
+		total_bytes += bytes;
+		if (t.count == 0 && t.has_calls + t.get_calls + t.insert_calls + t.remove_calls == 0)
+			continue;
+		pools.push_back({
+			{ "type", t.type },
+			{ "count", t.count },
+			{ "capacity", t.capacity },
+			{ "bytes", bytes },
+			{ "component_bytes", t.component_bytes },
+			{ "entity_bytes", t.entity_bytes },
+			{ "index_bytes", t.index_bytes },
+			{ "index_pages", t.index_pages },
+			{ "index_occupancy", t.index_occupancy },
+			{ "shadowed", t.shadowed },
+			{ "has", t.has_calls },
+			{ "get", t.get_calls },
+			{ "insert", t.insert_calls },
+			{ "remove", t.remove_calls }
+		});
+	}
+	size_t registry_bytes = signatures.capacity() * sizeof(Signature)
+		+ (entity_generations.capacity() + free_indices.capacity()) * sizeof(unsigned int);
+	nlohmann::json out = {
+		{ "entities", entity_generations.size() - 1 - free_indices.size() }, // index 0 is the null entity
+		{ "registry_bytes", registry_bytes },
+		{ "total_bytes", total_bytes + registry_bytes },
+		{ "pools", pools }
+	};
+	return out.dump();
+}
@@ -1,68 +1,128 @@
 #pragma once
 #include <vector>
+#include <tuple>
+#include <utility>
+#include <map>
+#include <string>
 
 #include "tiny_ecs.hpp"
 #include "components.hpp"
+#include "character_index.hpp"
 
 #define SDL_MAIN_HANDLED
 #include <SDL.h>
 #include <SDL_mixer.h>
 
+// All component types of the game, the registry holds one container per type and the position in this list
+// is the component id used in entity signatures. A component that is not listed here cannot be stored.
+typedef TypeList<
+	BackgroundObj, ParticlePool, SwarmParticle, TreasureChest, DeathTimer, Motion,
+	Companion, Mesh*, BackgroundLayer, RenderRequest, ScreenState,
+	Projectile, FireBall, Enemy, Damage, Silenced, Statistics,
+	DebugComponent, vec3, ButtonItem, HitTimer, Reflect, TurnIndicator,
+	Attack, RunTowards, Gravity, Taunt, StatIndicator, CheckRoundTimer,
+	toolTip, CharIndicator, UIButton, Ultimate, Shield, Dot,
+	storyTellingBackground, Bleed, BleedIndicator, ShieldIcon, Rollable, Light,
+	BouncingArrow, Bird, Platform, PreciseCollider, HoverBox, Boulder,
+	Collider, CollisionShape, Attachment, RigidBody> ComponentTypes;
+
+// Name of every entry of ComponentTypes, in the same order. They key the capacity profiles and the "capacity" object
+// of level files, so unlike typeid names they must stay the same across compilers and when a type is renamed.
+static const char* const component_names[] = {
+	"BackgroundObj", "ParticlePool", "SwarmParticle", "TreasureChest", "DeathTimer", "Motion",
+	"Companion", "Mesh*", "BackgroundLayer", "RenderRequest", "ScreenState",
+	"Projectile", "FireBall", "Enemy", "Damage", "Silenced", "Statistics",
+	"DebugComponent", "vec3", "ButtonItem", "HitTimer", "Reflect", "TurnIndicator",
+	"Attack", "RunTowards", "Gravity", "Taunt", "StatIndicator", "CheckRoundTimer",
+	"toolTip", "CharIndicator", "UIButton", "Ultimate", "Shield", "Dot",
+	"storyTellingBackground", "Bleed", "BleedIndicator", "ShieldIcon", "Rollable", "Light",
+	"BouncingArrow", "Bird", "Platform", "PreciseCollider", "HoverBox", "Boulder",
+	"Collider", "CollisionShape", "Attachment", "RigidBody" };
+
 class ECSRegistry
 {
-	// Callbacks to remove a particular or all entities in the system
+	// One container per entry of ComponentTypes
+	template <typename List>
+	struct Storage;
+	template <typename... Component>
+	struct Storage<TypeList<Component...>>
+	{
+		typedef std::tuple<ComponentContainer<Component>...> type;
+	};
+	Storage<ComponentTypes>::type storage;
+
+	// Callbacks to remove a particular or all entities in the system, generated from 'storage' and indexed by component id
 	std::vector<ContainerInterface*> registry_list;
 
+	// Components owned by every entity index, maintained by the containers on insert/remove
+	std::vector<Signature> signatures = { Signature() };
+
+	// (parent, child) of every attachment, by the index of the parent, kept up to date by index_attachments
+	std::vector<std::vector<std::pair<Entity, Entity>>> attached_children;
+
+	// Current generation of every entity index (index 0 is the null entity) and the indices free for re-use
+	std::vector<unsigned int> entity_generations = { 0 };
+	std::vector<unsigned int> free_indices;
+
 public:
-	// Manually created list of all components this game has
-	ComponentContainer<BackgroundObj> deformableEntities;
-	ComponentContainer<ParticlePool> particlePools;
-	ComponentContainer<SwarmParticle> fireflySwarm;
-	ComponentContainer<TreasureChest> chests;
-	ComponentContainer<DeathTimer> deathTimers;
-	ComponentContainer<Motion> motions;
-	ComponentContainer<Collision> collisions;
-	ComponentContainer<Companion> companions;
-	ComponentContainer<Mesh*> meshPtrs;
-	ComponentContainer<BackgroundLayer> backgroundLayers;
-	ComponentContainer<RenderRequest> renderRequests;
-	ComponentContainer<ScreenState> screenStates;
-	ComponentContainer<Projectile> projectiles;
-	ComponentContainer<FireBall> FireBalls;
-	ComponentContainer<Enemy> enemies;
-	ComponentContainer<Damage> damages;
-	ComponentContainer<Silenced> silenced;
-	ComponentContainer<Statistics> stats;
-	ComponentContainer<DebugComponent> debugComponents;
-	ComponentContainer<vec3> colors;
-	ComponentContainer<ButtonItem> buttons;
-	ComponentContainer<HitTimer> hit_timer;
-	ComponentContainer<Reflect> reflects;
-	ComponentContainer<TurnIndicator> turnIndicators;
-	ComponentContainer<Attack> attackers;
-	ComponentContainer<RunTowards> runners;
-	ComponentContainer<Gravity> gravities;
-	ComponentContainer<Taunt> taunts;
-	ComponentContainer<StatIndicator> statsindicators;
-	ComponentContainer<CheckRoundTimer> checkRoundTimer;
-	ComponentContainer<toolTip> toolTip;
-	ComponentContainer<CharIndicator> charIndicator;
-	ComponentContainer<UIButton> uiButtons;
-	ComponentContainer<Ultimate> ultimate;
-	ComponentContainer<Shield> shield;
-	ComponentContainer<Dot> dots;
-	ComponentContainer<storyTellingBackground> storyTellingBackgrounds;
-	ComponentContainer<Bleed> bleeds;
-	ComponentContainer<BleedIndicator> bleedIndicators;
-	ComponentContainer<ShieldIcon> shieldIcons;
-	ComponentContainer<Rollable> rollables;
-	ComponentContainer<Light> light;
-	ComponentContainer<BouncingArrow> bouncingArrows;
-	ComponentContainer<Bird> bird;
-	ComponentContainer<Platform> platform;
-	ComponentContainer<PreciseCollider> preciseColliders;
-	ComponentContainer<HoverBox> hoverBox;
-	ComponentContainer<Boulder> boulders;
+	// Named access to the containers, they all live in 'storage'
+	ComponentContainer<BackgroundObj>& deformableEntities = pool<BackgroundObj>();
+	ComponentContainer<ParticlePool>& particlePools = pool<ParticlePool>();
+	ComponentContainer<SwarmParticle>& fireflySwarm = pool<SwarmParticle>();
+	ComponentContainer<TreasureChest>& chests = pool<TreasureChest>();
+	ComponentContainer<DeathTimer>& deathTimers = pool<DeathTimer>();
+	ComponentContainer<Motion>& motions = pool<Motion>();
+	ComponentContainer<Companion>& companions = pool<Companion>();
+	ComponentContainer<Mesh*>& meshPtrs = pool<Mesh*>();
+	ComponentContainer<BackgroundLayer>& backgroundLayers = pool<BackgroundLayer>();
+	ComponentContainer<RenderRequest>& renderRequests = pool<RenderRequest>();
+	ComponentContainer<ScreenState>& screenStates = pool<ScreenState>();
+	ComponentContainer<Projectile>& projectiles = pool<Projectile>();
+	ComponentContainer<FireBall>& FireBalls = pool<FireBall>();
+	ComponentContainer<Enemy>& enemies = pool<Enemy>();
+	ComponentContainer<Damage>& damages = pool<Damage>();
+	ComponentContainer<Silenced>& silenced = pool<Silenced>();
+	ComponentContainer<Statistics>& stats = pool<Statistics>();
+	ComponentContainer<DebugComponent>& debugComponents = pool<DebugComponent>();
+	ComponentContainer<vec3>& colors = pool<vec3>();
+	ComponentContainer<ButtonItem>& buttons = pool<ButtonItem>();
+	ComponentContainer<HitTimer>& hit_timer = pool<HitTimer>();
+	ComponentContainer<Reflect>& reflects = pool<Reflect>();
+	ComponentContainer<TurnIndicator>& turnIndicators = pool<TurnIndicator>();
+	ComponentContainer<Attack>& attackers = pool<Attack>();
+	ComponentContainer<RunTowards>& runners = pool<RunTowards>();
+	ComponentContainer<Gravity>& gravities = pool<Gravity>();
+	ComponentContainer<Taunt>& taunts = pool<Taunt>();
+	ComponentContainer<StatIndicator>& statsindicators = pool<StatIndicator>();
+	ComponentContainer<CheckRoundTimer>& checkRoundTimer = pool<CheckRoundTimer>();
+	ComponentContainer<toolTip>& toolTip = pool<::toolTip>();
+	ComponentContainer<CharIndicator>& charIndicator = pool<CharIndicator>();
+	ComponentContainer<UIButton>& uiButtons = pool<UIButton>();
+	ComponentContainer<Ultimate>& ultimate = pool<Ultimate>();
+	ComponentContainer<Shield>& shield = pool<Shield>();
+	ComponentContainer<Dot>& dots = pool<Dot>();
+	ComponentContainer<storyTellingBackground>& storyTellingBackgrounds = pool<storyTellingBackground>();
+	ComponentContainer<Bleed>& bleeds = pool<Bleed>();
+	ComponentContainer<BleedIndicator>& bleedIndicators = pool<BleedIndicator>();
+	ComponentContainer<ShieldIcon>& shieldIcons = pool<ShieldIcon>();
+	ComponentContainer<Rollable>& rollables = pool<Rollable>();
+	ComponentContainer<Light>& light = pool<Light>();
+	ComponentContainer<BouncingArrow>& bouncingArrows = pool<BouncingArrow>();
+	ComponentContainer<Bird>& bird = pool<Bird>();
+	ComponentContainer<Platform>& platform = pool<Platform>();
+	ComponentContainer<PreciseCollider>& preciseColliders = pool<PreciseCollider>();
+	ComponentContainer<HoverBox>& hoverBox = pool<HoverBox>();
+	ComponentContainer<Boulder>& boulders = pool<Boulder>();
+	ComponentContainer<Collider>& colliders = pool<Collider>();
+	ComponentContainer<CollisionShape>& collisionShapes = pool<CollisionShape>();
+	ComponentContainer<Attachment>& attachments = pool<Attachment>();
+	ComponentContainer<RigidBody>& rigidBodies = pool<RigidBody>();
+
+	// Companions and enemies by side and CharacterType, declared after the containers it refers to
+	CharacterIndex characters{ companions, enemies, stats, motions, deathTimers };
+
+	// Contact events of the last physics step, consumed by WorldSystem::handle_collisions
+	std::vector<Contact> contacts;
 
 	// Sounds
 	Mix_Music* background_music;
@@ -127,79 +187,213 @@ public:
 	unsigned int horizontalResolution = 0;
 	unsigned int verticalResolution = 0;
 
-	// constructor that adds all containers for looping over them
-	// IMPORTANT: Don't forget to add any newly added containers!
+	// Hand every container its component id and collect them for looping over them
+	template <size_t... I>
+	void register_containers(std::index_sequence<I...>)
+	{
+		static_assert(sizeof...(I) == sizeof(component_names) / sizeof(component_names[0]), "Every component type needs an entry in component_names");
+		using expand = int[];
+		(void)expand{ 0, (std::get<I>(storage).attach(&signatures, (unsigned int)I, component_names[I]), registry_list.push_back(&std::get<I>(storage)), 0)... };
+	}
+
+	// Keep attached_children in step with the attachment container, so children_of needs no scan
+	void index_attachments()
+	{
+		ComponentContainer<Attachment>& attached = pool<Attachment>();
+		attached.on_construct().connect([this](Entity child, Attachment& attachment) {
+			unsigned int parent = attachment.parent.index();
+			if (parent >= attached_children.size())
+				attached_children.resize(parent + 1);
+			attached_children[parent].emplace_back(attachment.parent, child);
+		});
+		attached.on_destroy().connect([this](Entity child, Attachment& attachment) {
+			std::vector<std::pair<Entity, Entity>>& list = attached_children[attachment.parent.index()];
+			list.erase(std::remove(list.begin(), list.end(), std::make_pair(attachment.parent, child)), list.end());
+		});
+	}
+
+	// constructor that adds all containers for looping over them, new containers only need an entry in ComponentTypes
 	ECSRegistry()
 	{
-		registry_list.push_back(&deformableEntities);
-		registry_list.push_back(&particlePools);
-		registry_list.push_back(&deathTimers);
-		registry_list.push_back(&motions);
-		registry_list.push_back(&collisions);
-		registry_list.push_back(&companions);
-		registry_list.push_back(&meshPtrs);
-		registry_list.push_back(&renderRequests);
-		registry_list.push_back(&screenStates);
-		registry_list.push_back(&projectiles);
-		registry_list.push_back(&FireBalls);
-		registry_list.push_back(&silenced);
-		registry_list.push_back(&enemies);
-		registry_list.push_back(&debugComponents);
-		registry_list.push_back(&colors);
-		registry_list.push_back(&buttons);
-		registry_list.push_back(&hit_timer);
-		registry_list.push_back(&reflects);
-		registry_list.push_back(&turnIndicators);
-		registry_list.push_back(&attackers);
-		registry_list.push_back(&gravities);
-		registry_list.push_back(&taunts);
-		registry_list.push_back(&runners);
-		registry_list.push_back(&checkRoundTimer);
-		registry_list.push_back(&statsindicators);
-		registry_list.push_back(&toolTip);
-		registry_list.push_back(&charIndicator);
-		registry_list.push_back(&uiButtons);
-		registry_list.push_back(&ultimate);
-		registry_list.push_back(&shield);
-		registry_list.push_back(&dots);
-		registry_list.push_back(&storyTellingBackgrounds);
-		registry_list.push_back(&bleeds);
-		registry_list.push_back(&bleedIndicators);
-		registry_list.push_back(&shieldIcons);
-		registry_list.push_back(&rollables);
-		registry_list.push_back(&light);
-		registry_list.push_back(&bouncingArrows);
-		registry_list.push_back(&bird);
-		registry_list.push_back(&platform);
-		registry_list.push_back(&chests);
-		registry_list.push_back(&preciseColliders);
-		registry_list.push_back(&hoverBox);
-		
-		registry_list.push_back(&boulders);
+		register_containers(std::make_index_sequence<std::tuple_size<decltype(storage)>::value>());
+		index_attachments();
+	}
+
+	// The named members refer into this object's storage, so it can't be copied
+	ECSRegistry(const ECSRegistry&) = delete;
+	ECSRegistry& operator=(const ECSRegistry&) = delete;
+
+	// Compile-time id of a component type, i.e. its bit in a Signature
+	template <typename Component>
+	static constexpr unsigned int component_id() {
+		return TypeIndex<Component, ComponentTypes>::value;
+	}
+
+	// Signature with the bits of all 'Component' types set
+	template <typename... Component>
+	static Signature mask() {
+		Signature m;
+		using expand = int[];
+		(void)expand{ 0, (m.set(component_id<Component>()), 0)... };
+		return m;
+	}
+
+	// The set of components entity e owns
+	Signature signature(Entity e) {
+		if (!valid(e) || e.index() >= signatures.size())
+			return Signature();
+		return signatures[e.index()];
+	}
+
+	// Check if entity e has every one of the 'Component' types, a single mask test
+	template <typename... Component>
+	bool has_all(Entity e) {
+		Signature m = mask<Component...>();
+		return (signature(e) & m) == m;
+	}
+
+	// Look up the container that stores components of type 'Component'
+	template <typename Component>
+	ComponentContainer<Component>& pool() {
+		return std::get<TypeIndex<Component, ComponentTypes>::value>(storage);
+	}
+
+	// All entities that have every 'Component' and none of the excluded ones, see View
+	template <typename... Component, typename... Excluded>
+	View<std::tuple<Component...>, std::tuple<Excluded...>> view(exclude_t<Excluded...> = {}) {
+		return View<std::tuple<Component...>, std::tuple<Excluded...>>(
+			std::make_tuple(&pool<Component>()...), &signatures, mask<Component...>(), mask<Excluded...>());
 	}
 
 	void clear_all_components() {
 		for (ContainerInterface* reg : registry_list)
 			reg->clear();
+		contacts.clear();
 	}
 
 	void list_all_components() {
 		printf("Debug info on all registry entries:\n");
 		for (ContainerInterface* reg : registry_list)
 			if (reg->size() > 0)
-				printf("%4d components of type %s\n", (int)reg->size(), typeid(*reg).name());
+				printf("%4d components of type %s\n", (int)reg->size(), reg->type_name());
 	}
 
 	void list_all_components_of(Entity e) {
 		printf("Debug info on components of entity %u:\n", (unsigned int)e);
 		for (ContainerInterface* reg : registry_list)
 			if (reg->has(e))
-				printf("type %s\n", typeid(*reg).name());
+				printf("type %s\n", reg->type_name());
 	}
 
-	void remove_all_components_of(Entity e) {
+	// Memory use and access counts of all containers, in component id order
+	std::vector<ContainerTelemetry> telemetry() const {
+		std::vector<ContainerTelemetry> result;
+		result.reserve(registry_list.size());
+		for (const ContainerInterface* reg : registry_list)
+			result.push_back(reg->telemetry());
+		return result;
+	}
+
+	// Start counting container accesses from zero, e.g. at the beginning of a frame
+	void reset_telemetry_counters() {
 		for (ContainerInterface* reg : registry_list)
-			reg->remove(e);
+			reg->reset_counters();
+	}
+
+	// Capacity to reserve for each container, by component type name (see component_names)
+	typedef std::map<std::string, size_t> CapacityProfile;
+
+	// The current capacity of every container that has allocated any, it is at least the peak size reached so far
+	CapacityProfile capacity_profile() const {
+		CapacityProfile profile;
+		for (const ContainerInterface* reg : registry_list)
+			if (reg->capacity() > 0)
+				profile[reg->type_name()] = reg->capacity();
+		return profile;
+	}
+
+	// Reserve the capacities of a profile, so that filling the containers up to them does not re-allocate
+	// Types the registry does not know (e.g. from a profile recorded by an older build) are ignored.
+	void reserve(const CapacityProfile& profile) {
+		for (ContainerInterface* reg : registry_list) {
+			auto it = profile.find(reg->type_name());
+			if (it != profile.end())
+				reg->reserve(it->second);
+		}
+	}
+
+	// The telemetry of all non-empty or accessed containers plus the registry's own bookkeeping as a single line of JSON
+	std::string telemetry_json() const;
+
+	// Only visits the containers named in the entity's signature
+	// Entities attached to it keep their components, see destroy for removing them too
+	void remove_all_components_of(Entity e) {
+		Signature s = signature(e);
+		for (unsigned int id = 0; s.any() && id < registry_list.size(); id++)
+			if (s.test(id)) {
+				registry_list[id]->remove(e);
+				s.reset(id);
+			}
+	}
+
+	// Appends the entities attached to e to 'out'
+	void children_of(Entity e, std::vector<Entity>& out) const {
+		if (e.index() >= attached_children.size())
+			return;
+		for (const std::pair<Entity, Entity>& attachment : attached_children[e.index()])
+			if (attachment.first == e)
+				out.push_back(attachment.second);
+	}
+
+	// Hands out a new entity, re-using the index of a destroyed one if possible
+	Entity create() {
+		if (!free_indices.empty()) {
+			unsigned int index = free_indices.back();
+			free_indices.pop_back();
+			return Entity(index, entity_generations[index]);
+		}
+		assert(entity_generations.size() <= Entity::index_mask && "Out of entity indices");
+		entity_generations.push_back(0);
+		signatures.resize(entity_generations.size());
+		return Entity((unsigned int)entity_generations.size() - 1, 0);
+	}
+
+	// Check that the handle refers to a live entity and not to a destroyed one whose index was re-used
+	bool valid(Entity e) {
+		return e.index() != 0 && e.index() < entity_generations.size() && entity_generations[e.index()] == e.generation();
+	}
+
+	// Removes all components of the entity and releases its index, handles to it become invalid
+	// Entities attached to it are destroyed with it
+	void destroy(Entity e) {
+		if (!valid(e))
+			return;
+		// The whole tree is collected first, removing the attachments empties the child lists
+		std::vector<Entity> doomed = { e };
+		for (size_t i = 0; i < doomed.size(); i++)
+			children_of(doomed[i], doomed);
+		for (Entity d : doomed) {
+			remove_all_components_of(d);
+			release(d);
+		}
+	}
+
+	// Releases the index of an entity whose components were already removed (see CommandBuffer::flush)
+	void release(Entity e) {
+		if (!valid(e))
+			return;
+		entity_generations[e.index()] = (e.generation() + 1) & Entity::generation_mask;
+		free_indices.push_back(e.index());
+	}
+
+	// The container with the given component id
+	ContainerInterface& container(unsigned int id) {
+		return *registry_list[id];
+	}
+
+	// Number of component types, i.e. of containers
+	static constexpr unsigned int component_count() {
+		return (unsigned int)std::tuple_size<Storage<ComponentTypes>::type>::value;
 	}
 };
 
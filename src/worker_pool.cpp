@@ -0,0 +1,107 @@
+// internal
+#include "worker_pool.hpp"
+
+// stlib
+#include <algorithm>
+
+WorkerPool::WorkerPool(unsigned int threads)
+	: threads(threads), next_chunk(0), finished_chunks(0)
+{
+	if (this->threads == 0)
+		this->threads = std::max(1u, std::thread::hardware_concurrency());
+}
+
+WorkerPool::~WorkerPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	wake.notify_all();
+	for (std::thread& worker : workers)
+		worker.join();
+}
+
+unsigned int WorkerPool::thread_count() const
+{
+	return threads;
+}
+
+size_t WorkerPool::chunk_count(size_t count, size_t grain)
+{
+	grain = std::max<size_t>(grain, 1);
+	return (count + grain - 1) / grain;
+}
+
+void WorkerPool::run(size_t count, size_t grain, const std::function<void(size_t, size_t, size_t)>& job)
+{
+	grain = std::max<size_t>(grain, 1);
+	size_t chunks = chunk_count(count, grain);
+	if (chunks <= 1 || threads <= 1)
+	{
+		for (size_t chunk = 0; chunk < chunks; chunk++)
+			job(chunk, chunk * grain, std::min(count, (chunk + 1) * grain));
+		return;
+	}
+
+	if (workers.empty())
+		for (unsigned int i = 1; i < threads; i++)
+			workers.emplace_back(&WorkerPool::work, this);
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		this->job = &job;
+		this->count = count;
+		this->grain = grain;
+		this->chunks = chunks;
+		next_chunk = 0;
+		finished_chunks = 0;
+		generation++;
+	}
+	wake.notify_all();
+
+	while (run_chunk())
+		;
+
+	// No worker may still be looking at the job once it is cleared
+	std::unique_lock<std::mutex> lock(mutex);
+	done.wait(lock, [this]() { return finished_chunks == this->chunks && busy == 0; });
+	this->job = nullptr;
+}
+
+bool WorkerPool::run_chunk()
+{
+	size_t chunk = next_chunk++;
+	if (chunk >= chunks)
+		return false;
+	(*job)(chunk, chunk * grain, std::min(count, (chunk + 1) * grain));
+	if (++finished_chunks == chunks)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		done.notify_all();
+	}
+	return true;
+}
+
+void WorkerPool::work()
+{
+	unsigned int seen = 0;
+	for (;;)
+	{
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			wake.wait(lock, [&]() { return stopping || (job != nullptr && generation != seen); });
+			if (stopping)
+				return;
+			seen = generation;
+			busy++;
+		}
+		while (run_chunk())
+			;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			busy--;
+		}
+		done.notify_all();
+	}
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+
+// Runs the chunks of a loop on a set of worker threads and the calling thread
+// [0, count) is cut into chunks of 'grain' items, which depends only on count and grain. A job that writes the
+// results of each chunk to a slot of its own, merged in chunk order afterwards, therefore gives the same output for
+// any number of threads. The workers are started on the first job worth splitting.
+// The calling thread waits in run until every chunk is done. Jobs may read the registry and game state it left
+// them, but must only write to the items of their own chunk and must not add or remove components.
+class WorkerPool
+{
+public:
+	// 'threads' counts the calling thread, 0 uses one per hardware thread
+	explicit WorkerPool(unsigned int threads = 0);
+	~WorkerPool();
+	WorkerPool(const WorkerPool&) = delete;
+	WorkerPool& operator=(const WorkerPool&) = delete;
+
+	unsigned int thread_count() const;
+
+	// Number of chunks 'count' items are cut into
+	static size_t chunk_count(size_t count, size_t grain);
+
+	// Call job(chunk, begin, end) for every chunk and return when all are done, a single chunk runs on the caller
+	void run(size_t count, size_t grain, const std::function<void(size_t, size_t, size_t)>& job);
+
+private:
+	unsigned int threads;
+	std::vector<std::thread> workers;
+
+	std::mutex mutex;
+	std::condition_variable wake;
+	std::condition_variable done;
+	bool stopping = false;
+	unsigned int generation = 0;
+	// Workers inside the current job
+	unsigned int busy = 0;
+
+	// The current job, set under 'mutex' while run() is in progress
+	const std::function<void(size_t, size_t, size_t)>* job = nullptr;
+	size_t count = 0;
+	size_t grain = 1;
+	size_t chunks = 0;
+	std::atomic<size_t> next_chunk;
+	std::atomic<size_t> finished_chunks;
+
+	void work();
+	// Run the next chunk of the current job, false once all of them are taken
+	bool run_chunk();
+};
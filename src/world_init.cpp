@@ -3,7 +3,7 @@
 
 Entity createPlayerMage(RenderSystem* renderer, vec2 pos)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::MAGE_IDLE);
 	registry.meshPtrs.emplace(entity, &mesh);
@@ -24,7 +24,7 @@ Entity createPlayerMage(RenderSystem* renderer, vec2 pos)
 
 	// Add a healthbar
 	Companion& companion = registry.companions.emplace(entity);
-	companion.healthbar = createHealthBar(renderer, pos);
+	companion.healthbar = createHealthBar(renderer, pos, entity);
 	companion.companionType = MAGE;
 
 	registry.renderRequests.insert(
@@ -33,12 +33,14 @@ Entity createPlayerMage(RenderSystem* renderer, vec2 pos)
 			EFFECT_ASSET_ID::TEXTURED,
 			GEOMETRY_BUFFER_ID::MAGE_IDLE });
 
+	addCollider(entity, LAYER_CHARACTER);
+
 	return entity;
 }
 
 Entity createBird(RenderSystem* renderer, vec2 pos)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::DRAGON_FLYING);
 	registry.meshPtrs.emplace(entity, &mesh);
@@ -61,13 +63,15 @@ Entity createBird(RenderSystem* renderer, vec2 pos)
 			EFFECT_ASSET_ID::TEXTURED,
 			GEOMETRY_BUFFER_ID::DRAGON_FLYING });
 
+	addCollider(entity, LAYER_CHARACTER);
+
 	return entity;
 }
 
 void createSpline(RenderSystem* renderer, std::vector<vec3> points)
 {
 	for (auto& point : points) {
-		auto entity = Entity();
+		auto entity = registry.create();
 
 		Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::SPRITE);
 		registry.meshPtrs.emplace(entity, &mesh);
@@ -88,7 +92,7 @@ void createSpline(RenderSystem* renderer, std::vector<vec3> points)
 
 Entity createEnemyMage(RenderSystem* renderer, vec2 pos)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::MAGE_IDLE);
 	registry.meshPtrs.emplace(entity, &mesh);
@@ -106,9 +110,11 @@ Entity createEnemyMage(RenderSystem* renderer, vec2 pos)
 	stat.speed = 13;
 
 	// Add a healthbar
-	Enemy& enemy = registry.enemies.emplace(entity);
-	enemy.healthbar = createHealthBar(renderer, pos);
+	// The enemy gets its healthbar before it is inserted, so the render system sees it (see RenderSystem::init)
+	Enemy enemy;
+	enemy.healthbar = createHealthBar(renderer, pos, entity);
 	enemy.enemyType = MAGE;
+	registry.enemies.insert(entity, enemy);
 
 	registry.renderRequests.insert(
 		entity,
@@ -116,12 +122,14 @@ Entity createEnemyMage(RenderSystem* renderer, vec2 pos)
 			EFFECT_ASSET_ID::TEXTURED,
 			GEOMETRY_BUFFER_ID::MAGE_IDLE });
 
+	addCollider(entity, LAYER_CHARACTER);
+
 	return entity;
 }
 
 Entity createBackgroundObject(RenderSystem* renderer, vec2 pos)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	// Store a reference to the potentially re-used mesh object
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::BACKGROUND_OBJ);
@@ -142,12 +150,15 @@ Entity createBackgroundObject(RenderSystem* renderer, vec2 pos)
 			GEOMETRY_BUFFER_ID::BACKGROUND_OBJ });
 
 	registry.deformableEntities.insert(entity, {});
+	addCollider(entity, LAYER_OBSTACLE);
+	setBodyType(entity, BodyType::STATIC);
+
 	return entity;
 }
 
 Entity createPlayerSwordsman(RenderSystem* renderer, vec2 pos)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::SWORDSMAN_IDLE);
 	registry.meshPtrs.emplace(entity, &mesh);
@@ -167,7 +178,7 @@ Entity createPlayerSwordsman(RenderSystem* renderer, vec2 pos)
 
 	// Add a healthbar
 	Companion& companion = registry.companions.emplace(entity);
-	companion.healthbar = createHealthBar(renderer, { pos.x, pos.y - 20 });
+	companion.healthbar = createHealthBar(renderer, { pos.x, pos.y - 20 }, entity);
 	companion.companionType = SWORDSMAN;
 
 	auto& abc = registry.renderRequests.insert(
@@ -176,12 +187,14 @@ Entity createPlayerSwordsman(RenderSystem* renderer, vec2 pos)
 			EFFECT_ASSET_ID::TEXTURED,
 			GEOMETRY_BUFFER_ID::SWORDSMAN_IDLE });
 
+	addCollider(entity, LAYER_CHARACTER);
+
 	return entity;
 }
 
 Entity createPlayerArcher(RenderSystem* renderer, vec2 pos, int isFreeRoamArcher)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::ARCHER_IDLE);
 	registry.meshPtrs.emplace(entity, &mesh);
@@ -202,7 +215,7 @@ Entity createPlayerArcher(RenderSystem* renderer, vec2 pos, int isFreeRoamArcher
 
 		// Add a healthbar
 		Companion& companion = registry.companions.emplace(entity);
-		companion.healthbar = createHealthBar(renderer, { pos.x, pos.y - 20 });
+		companion.healthbar = createHealthBar(renderer, { pos.x, pos.y - 20 }, entity);
 		companion.companionType = ARCHER;
 		companion.curr_anim_type = IDLE;
 	}
@@ -220,6 +233,8 @@ Entity createPlayerArcher(RenderSystem* renderer, vec2 pos, int isFreeRoamArcher
 		motion.scale = vec2({ ARCHER_FREEROAM_WIDTH, ARCHER_FREEROAM_HEIGHT });
 	}
 
+	addCollider(entity, LAYER_CHARACTER);
+
 	auto& abc = registry.renderRequests.insert(
 		entity,
 		{ TEXTURE_ASSET_ID::ARCHER_ANIMS,
@@ -231,7 +246,7 @@ Entity createPlayerArcher(RenderSystem* renderer, vec2 pos, int isFreeRoamArcher
 
 Entity createEnemySwordsman(RenderSystem* renderer, vec2 pos)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::SWORDSMAN_IDLE);
 	registry.meshPtrs.emplace(entity, &mesh);
@@ -249,9 +264,10 @@ Entity createEnemySwordsman(RenderSystem* renderer, vec2 pos)
 	stat.speed = 10;
 
 	// Add a healthbar
-	Enemy& enemy = registry.enemies.emplace(entity);
-	enemy.healthbar = createHealthBar(renderer, { pos.x, pos.y - 20 });
+	Enemy enemy;
+	enemy.healthbar = createHealthBar(renderer, { pos.x, pos.y - 20 }, entity);
 	enemy.enemyType = SWORDSMAN;
+	registry.enemies.insert(entity, enemy);
 
 	registry.renderRequests.insert(
 		entity,
@@ -259,12 +275,14 @@ Entity createEnemySwordsman(RenderSystem* renderer, vec2 pos)
 			EFFECT_ASSET_ID::TEXTURED,
 			GEOMETRY_BUFFER_ID::SWORDSMAN_IDLE });
 
+	addCollider(entity, LAYER_CHARACTER);
+
 	return entity;
 }
 
 Entity createNecromancerMinion(RenderSystem* renderer, vec2 pos)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::NECRO_MINION_IDLE);
 	registry.meshPtrs.emplace(entity, &mesh);
@@ -282,12 +300,13 @@ Entity createNecromancerMinion(RenderSystem* renderer, vec2 pos)
 	stat.speed = 0;
 
 	// Add a healthbar
-	Enemy& enemy = registry.enemies.emplace(entity);
-	enemy.healthbar = createHealthBar(renderer, {pos.x, pos.y - motion.scale.y/2});
+	Enemy enemy;
+	enemy.healthbar = createHealthBar(renderer, {pos.x, pos.y - motion.scale.y/2}, entity);
 	enemy.enemyType = NECROMANCER_MINION;
 
 	// Minion should use appearing anim initially
 	enemy.curr_anim_type = APPEARING;
+	registry.enemies.insert(entity, enemy);
 
 	registry.renderRequests.insert(
 		entity,
@@ -295,13 +314,15 @@ Entity createNecromancerMinion(RenderSystem* renderer, vec2 pos)
 			EFFECT_ASSET_ID::TEXTURED,
 			GEOMETRY_BUFFER_ID::NECRO_MINION_APPEAR });
 
+	addCollider(entity, LAYER_CHARACTER);
+
 	return entity;
 }
 
 
 Entity createNecromancerPhaseOne(RenderSystem* renderer, vec2 pos)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::NECRO_ONE_IDLE);
 	registry.meshPtrs.emplace(entity, &mesh);
@@ -319,9 +340,10 @@ Entity createNecromancerPhaseOne(RenderSystem* renderer, vec2 pos)
 	stat.speed = 1;
 
 	// Add a healthbar
-	Enemy& enemy = registry.enemies.emplace(entity);
-	enemy.healthbar = createHealthBar(renderer, { pos.x, pos.y - motion.scale.y / 2 });
+	Enemy enemy;
+	enemy.healthbar = createHealthBar(renderer, { pos.x, pos.y - motion.scale.y / 2 }, entity);
 	enemy.enemyType = NECROMANCER_ONE;
+	registry.enemies.insert(entity, enemy);
 
 	registry.renderRequests.insert(
 		entity,
@@ -329,12 +351,14 @@ Entity createNecromancerPhaseOne(RenderSystem* renderer, vec2 pos)
 			EFFECT_ASSET_ID::TEXTURED,
 			GEOMETRY_BUFFER_ID::NECRO_ONE_IDLE });
 
+	addCollider(entity, LAYER_CHARACTER);
+
 	return entity;
 }
 
 Entity createNecromancerPhaseTwo(RenderSystem* renderer, vec2 pos)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::NECRO_TWO_IDLE);
 	registry.meshPtrs.emplace(entity, &mesh);
@@ -352,9 +376,10 @@ Entity createNecromancerPhaseTwo(RenderSystem* renderer, vec2 pos)
 	stat.speed = 2;
 
 	// Add a healthbar
-	Enemy& enemy = registry.enemies.emplace(entity);
-	enemy.healthbar = createHealthBar(renderer, { pos.x, pos.y - motion.scale.y / 4 });
+	Enemy enemy;
+	enemy.healthbar = createHealthBar(renderer, { pos.x, pos.y - motion.scale.y / 4 }, entity);
 	enemy.enemyType = NECROMANCER_TWO;
+	registry.enemies.insert(entity, enemy);
 
 	// Emplace ultimate component to delay ultimate attack
 	Ultimate& u = registry.ultimate.emplace(entity);
@@ -366,12 +391,14 @@ Entity createNecromancerPhaseTwo(RenderSystem* renderer, vec2 pos)
 			EFFECT_ASSET_ID::TEXTURED,
 			GEOMETRY_BUFFER_ID::NECRO_TWO_IDLE });
 
+	addCollider(entity, LAYER_CHARACTER);
+
 	return entity;
 }
 
 Entity createFireBall(RenderSystem* renderer, vec2 position, float angle, vec2 velocity, int isFriendly)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::SPRITE);
 	registry.meshPtrs.emplace(entity, &mesh);
@@ -392,6 +419,7 @@ Entity createFireBall(RenderSystem* renderer, vec2 position, float angle, vec2 v
 	//------------------------------------------------
 
 	registry.projectiles.emplace(entity);
+	addCollider(entity, LAYER_PROJECTILE);
 	registry.FireBalls.emplace(entity);
 	registry.renderRequests.insert(
 		entity,
@@ -405,9 +433,9 @@ Entity createFireBall(RenderSystem* renderer, vec2 position, float angle, vec2 v
 
 Entity createArrow(RenderSystem* renderer, vec2 position, float angle, vec2 velocity, int isFriendly, int isFreeRoam)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 
-	Mesh& mesh = (isFreeRoam) ? renderer->getMesh(GEOMETRY_BUFFER_ID::SIMPLIFIED_ARROW_MESH) : renderer->getMesh(GEOMETRY_BUFFER_ID::SPRITE);
+	Mesh& mesh = (isFreeRoam) ? renderer->getCollisionMesh(GEOMETRY_BUFFER_ID::ARROW_MESH) : renderer->getMesh(GEOMETRY_BUFFER_ID::SPRITE);
 	registry.meshPtrs.emplace(entity, &mesh);
 	auto& gravity = registry.gravities.emplace(entity);
 	gravity.gravity = 30;
@@ -418,6 +446,7 @@ Entity createArrow(RenderSystem* renderer, vec2 position, float angle, vec2 velo
 	motion.position = position;
 	
 	registry.projectiles.emplace(entity);
+	addCollider(entity, LAYER_PROJECTILE);
 	registry.preciseColliders.emplace(entity);
 
 	if (isFreeRoam) {
@@ -457,7 +486,7 @@ Entity createArrow(RenderSystem* renderer, vec2 position, float angle, vec2 velo
 
 Entity createIceShard(RenderSystem* renderer, vec2 position, float angle, vec2 velocity, int isFriendly)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::SPRITE);
 	registry.meshPtrs.emplace(entity, &mesh);
@@ -476,6 +505,7 @@ Entity createIceShard(RenderSystem* renderer, vec2 position, float angle, vec2 v
 	//------------------------------------------------
 
 	registry.projectiles.emplace(entity);
+	addCollider(entity, LAYER_PROJECTILE);
 	registry.renderRequests.insert(
 		entity,
 		{ TEXTURE_ASSET_ID::ICESHARD,
@@ -487,7 +517,7 @@ Entity createIceShard(RenderSystem* renderer, vec2 position, float angle, vec2 v
 
 Entity createIceShardIcon(RenderSystem* renderer, vec2 position)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::SPRITE);
 	registry.meshPtrs.emplace(entity, &mesh);
@@ -505,12 +535,14 @@ Entity createIceShardIcon(RenderSystem* renderer, vec2 position)
 		 EFFECT_ASSET_ID::TEXTURED,
 		 GEOMETRY_BUFFER_ID::SPRITE });
 
+	setBodyType(entity, BodyType::STATIC);
+
 	return entity;
 }
 
 Entity createFireballIcon(RenderSystem* renderer, vec2 position)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::SPRITE);
 	registry.meshPtrs.emplace(entity, &mesh);
@@ -528,13 +560,15 @@ Entity createFireballIcon(RenderSystem* renderer, vec2 position)
 		 EFFECT_ASSET_ID::TEXTURED,
 		 GEOMETRY_BUFFER_ID::SPRITE });
 
+	setBodyType(entity, BodyType::STATIC);
+
 	return entity;
 }
 
 //melee icon
 Entity createMeleeIcon(RenderSystem* renderer, vec2 position)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::SPRITE);
 	registry.meshPtrs.emplace(entity, &mesh);
@@ -552,12 +586,14 @@ Entity createMeleeIcon(RenderSystem* renderer, vec2 position)
 		 EFFECT_ASSET_ID::TEXTURED,
 		 GEOMETRY_BUFFER_ID::SPRITE });
 
+	setBodyType(entity, BodyType::STATIC);
+
 	return entity;
 }
 //arrow icon
 Entity createArrowIcon(RenderSystem* renderer, vec2 position)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::SPRITE);
 	registry.meshPtrs.emplace(entity, &mesh);
@@ -575,13 +611,15 @@ Entity createArrowIcon(RenderSystem* renderer, vec2 position)
 		 EFFECT_ASSET_ID::TEXTURED,
 		 GEOMETRY_BUFFER_ID::SPRITE });
 
+	setBodyType(entity, BodyType::STATIC);
+
 	return entity;
 }
 
 //taunt icon
 Entity createTauntIcon(RenderSystem* renderer, vec2 position)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::SPRITE);
 	registry.meshPtrs.emplace(entity, &mesh);
@@ -599,13 +637,15 @@ Entity createTauntIcon(RenderSystem* renderer, vec2 position)
 		 EFFECT_ASSET_ID::TEXTURED,
 		 GEOMETRY_BUFFER_ID::SPRITE });
 
+	setBodyType(entity, BodyType::STATIC);
+
 	return entity;
 }
 
 //heal icon
 Entity createHealIcon(RenderSystem* renderer, vec2 position)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::SPRITE);
 	registry.meshPtrs.emplace(entity, &mesh);
@@ -623,13 +663,15 @@ Entity createHealIcon(RenderSystem* renderer, vec2 position)
 		 EFFECT_ASSET_ID::TEXTURED,
 		 GEOMETRY_BUFFER_ID::SPRITE });
 
+	setBodyType(entity, BodyType::STATIC);
+
 	return entity;
 }
 
 //rock icon
 Entity createRockIcon(RenderSystem* renderer, vec2 position)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::SPRITE);
 	registry.meshPtrs.emplace(entity, &mesh);
@@ -647,12 +689,14 @@ Entity createRockIcon(RenderSystem* renderer, vec2 position)
 		 EFFECT_ASSET_ID::TEXTURED,
 		 GEOMETRY_BUFFER_ID::SPRITE });
 
+	setBodyType(entity, BodyType::STATIC);
+
 	return entity;
 }
 
 Entity createSilenceIcon(RenderSystem* renderer, vec2 position)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::SPRITE);
 	registry.meshPtrs.emplace(entity, &mesh);
@@ -670,12 +714,14 @@ Entity createSilenceIcon(RenderSystem* renderer, vec2 position)
 		 EFFECT_ASSET_ID::TEXTURED,
 		 GEOMETRY_BUFFER_ID::SPRITE });
 
+	setBodyType(entity, BodyType::STATIC);
+
 	return entity;
 }
 
 Entity createSilenceIconSelected(RenderSystem* renderer, vec2 position)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::SPRITE);
 	registry.meshPtrs.emplace(entity, &mesh);
@@ -693,13 +739,15 @@ Entity createSilenceIconSelected(RenderSystem* renderer, vec2 position)
 		 EFFECT_ASSET_ID::TEXTURED,
 		 GEOMETRY_BUFFER_ID::SPRITE });
 
+	setBodyType(entity, BodyType::STATIC);
+
 	return entity;
 }
 
 //turn indicators
 Entity createPlayerTurn(RenderSystem* renderer, vec2 position)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::SPRITE);
 	registry.meshPtrs.emplace(entity, &mesh);
@@ -716,12 +764,14 @@ Entity createPlayerTurn(RenderSystem* renderer, vec2 position)
 		 EFFECT_ASSET_ID::TEXTURED,
 		 GEOMETRY_BUFFER_ID::SPRITE });
 
+	setBodyType(entity, BodyType::STATIC);
+
 	return entity;
 }
 
 Entity createEnemyTurn(RenderSystem* renderer, vec2 position)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::SPRITE);
 	registry.meshPtrs.emplace(entity, &mesh);
@@ -738,26 +788,25 @@ Entity createEnemyTurn(RenderSystem* renderer, vec2 position)
 		 EFFECT_ASSET_ID::TEXTURED,
 		 GEOMETRY_BUFFER_ID::SPRITE });
 
+	setBodyType(entity, BodyType::STATIC);
+
 	return entity;
 }
 
 Entity createCharIndicator(RenderSystem* renderer, vec2 position, Entity owner)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	// Store a reference to the potentially re-used mesh object (the value is stored in the resource cache)
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::SPRITE);
 	registry.meshPtrs.emplace(entity, &mesh);
 
-	auto& charInd = registry.charIndicator.emplace(entity);
-	charInd.owner = owner;
+	registry.charIndicator.emplace(entity);
 
 	// Initialize the motion
 	auto& motion = registry.motions.emplace(entity);
-	position[1] -= 150;
-	motion.position = position;
 	motion.scale = vec2({ CHARARROW_WIDTH, CHARARROW_HEIGHT });
-
+	placeCharIndicator(entity, position, owner);
 
 	registry.renderRequests.insert(
 		entity,
@@ -772,7 +821,7 @@ Entity createCharIndicator(RenderSystem* renderer, vec2 position, Entity owner)
 // create barrier
 Entity createBarrier(RenderSystem* renderer, vec2 position)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::SPRITE);
 	registry.meshPtrs.emplace(entity, &mesh);
@@ -800,6 +849,7 @@ Entity createBarrier(RenderSystem* renderer, vec2 position)
 			GEOMETRY_BUFFER_ID::SHIELD_MESH });
 
 	registry.deformableEntities.insert(entity, {});
+	addCollider(entity, LAYER_OBSTACLE);
 
 	return entity;
 }
@@ -807,7 +857,7 @@ Entity createBarrier(RenderSystem* renderer, vec2 position)
 
 Entity createFirefly(RenderSystem* renderer, vec2 position)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::SPRITE);
 	registry.meshPtrs.emplace(entity, &mesh);
@@ -818,6 +868,7 @@ Entity createFirefly(RenderSystem* renderer, vec2 position)
 	motion.velocity = vec2(0.f, 0.f);
 
 	auto& firefly = registry.fireflySwarm.emplace(entity);
+	addCollider(entity, LAYER_FIREFLY);
 	// registry.light.emplace(entity);
 
 	registry.renderRequests.insert(
@@ -831,7 +882,7 @@ Entity createFirefly(RenderSystem* renderer, vec2 position)
 
 Entity createPlatform(RenderSystem* renderer, vec2 position)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::SPRITE);
 	registry.meshPtrs.emplace(entity, &mesh);
@@ -841,6 +892,7 @@ Entity createPlatform(RenderSystem* renderer, vec2 position)
 	motion.scale = vec2({ PLATFORM_WIDTH, PLATFORM_HEIGHT });
 
 	registry.platform.emplace(entity);
+	addCollider(entity, LAYER_PLATFORM);
 
 	registry.renderRequests.insert(
 		entity,
@@ -848,12 +900,14 @@ Entity createPlatform(RenderSystem* renderer, vec2 position)
 			EFFECT_ASSET_ID::TEXTURED,
 			GEOMETRY_BUFFER_ID::SPRITE });
 
+	setBodyType(entity, BodyType::STATIC);
+
 	return entity;
 }
 
 Entity createRockMesh(RenderSystem* renderer, vec2 position)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::ROCK_MESH);
 	registry.meshPtrs.emplace(entity, &mesh);
@@ -873,7 +927,7 @@ Entity createRockMesh(RenderSystem* renderer, vec2 position)
 
 Entity createTreasureChest(RenderSystem* renderer, vec2 position, int chestType)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::TREASURE_CHEST_CLOSED);
 	registry.meshPtrs.emplace(entity, &mesh);
@@ -883,6 +937,7 @@ Entity createTreasureChest(RenderSystem* renderer, vec2 position, int chestType)
 	motion.scale = vec2({ TREASURE_CHEST_WIDTH, TREASURE_CHEST_HEIGHT });
 
 	auto& chest = registry.chests.emplace(entity);
+	addCollider(entity, LAYER_CHEST);
 	chest.chestType = chestType;
 
 	registry.renderRequests.insert(
@@ -891,12 +946,14 @@ Entity createTreasureChest(RenderSystem* renderer, vec2 position, int chestType)
 			EFFECT_ASSET_ID::TEXTURED,
 			GEOMETRY_BUFFER_ID::TREASURE_CHEST_CLOSED });
 
+	setBodyType(entity, BodyType::STATIC);
+
 	return entity;
 }
 
 Entity createGreenCross(RenderSystem* renderer, vec2 position)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::SPRITE);
 	registry.meshPtrs.emplace(entity, &mesh);
@@ -919,7 +976,7 @@ Entity createGreenCross(RenderSystem* renderer, vec2 position)
 
 Entity createBoostMessage(RenderSystem* renderer, vec2 position, int boostType)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::SPRITE);
 	registry.meshPtrs.emplace(entity, &mesh);
@@ -946,7 +1003,7 @@ Entity createBoostMessage(RenderSystem* renderer, vec2 position, int boostType)
 
 Entity createMeteorShower(RenderSystem* renderer, vec2 position, int isFriendly)
 {	
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::SPRITE);
 	registry.meshPtrs.emplace(entity, &mesh);
@@ -975,7 +1032,7 @@ Entity createMeteorShower(RenderSystem* renderer, vec2 position, int isFriendly)
 
 Entity createTauntIndicator(RenderSystem* renderer, Entity owner)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::SPRITE);
 	registry.meshPtrs.emplace(entity, &mesh);
@@ -995,11 +1052,17 @@ Entity createTauntIndicator(RenderSystem* renderer, Entity owner)
 		 EFFECT_ASSET_ID::TEXTURED,
 		 GEOMETRY_BUFFER_ID::SPRITE });
 
+	// lower it for mage
+	vec2 offset = { 20.f, registry.characters.type_of(owner) == MAGE ? -20.f : -50.f };
+	if (registry.motions.has(owner))
+		registry.motions.get_mut(entity).position = registry.motions.get(owner).position + offset;
+	attach(entity, owner);
+
 	return entity;
 }
 Entity createBleedIndicator(RenderSystem* renderer, Entity owner)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::SPRITE);
 	registry.meshPtrs.emplace(entity, &mesh);
@@ -1019,6 +1082,12 @@ Entity createBleedIndicator(RenderSystem* renderer, Entity owner)
 		 EFFECT_ASSET_ID::TEXTURED,
 		 GEOMETRY_BUFFER_ID::SPRITE });
 
+	// lower it for mage
+	vec2 offset = { 20.f, registry.characters.type_of(owner) == MAGE ? 0.f : -30.f };
+	if (registry.motions.has(owner))
+		registry.motions.get_mut(entity).position = registry.motions.get(owner).position + offset;
+	attach(entity, owner);
+
 	return entity;
 }
 
@@ -1026,7 +1095,7 @@ Entity createBleedIndicator(RenderSystem* renderer, Entity owner)
 // create rock
 Entity createRock(RenderSystem* renderer, vec2 position, int isFriendly)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::SPRITE);
 	registry.meshPtrs.emplace(entity, &mesh);
@@ -1039,6 +1108,7 @@ Entity createRock(RenderSystem* renderer, vec2 position, int isFriendly)
 	motion.scale = vec2({ ROCK_WIDTH, ROCK_HEIGHT });
 
 	auto& proj = registry.projectiles.emplace(entity);
+	addCollider(entity, LAYER_PROJECTILE);
 	proj.enableCameraTracking = 0;
 
 	// Set damage here--------------------------------
@@ -1060,7 +1130,7 @@ Entity createRock(RenderSystem* renderer, vec2 position, int isFriendly)
 // create cpike
 Entity createSpike(RenderSystem* renderer, vec2 position, int isFriendly)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::SPRITE);
 	registry.meshPtrs.emplace(entity, &mesh);
@@ -1073,6 +1143,7 @@ Entity createSpike(RenderSystem* renderer, vec2 position, int isFriendly)
 	motion.scale = vec2({ SPIKE_WIDTH, SPIKE_HEIGHT });
 
 	auto& proj = registry.projectiles.emplace(entity);
+	addCollider(entity, LAYER_PROJECTILE);
 	proj.enableCameraTracking = 0;
 
 	// Set damage here--------------------------------
@@ -1093,10 +1164,10 @@ Entity createSpike(RenderSystem* renderer, vec2 position, int isFriendly)
 
 Entity createBoulder(RenderSystem* renderer, vec2 pos)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	// Store a reference to the potentially re-used mesh object
-	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::SIMPLIFIED_ROCK_MESH);
+	Mesh& mesh = renderer->getCollisionMesh(GEOMETRY_BUFFER_ID::ROCK_MESH);
 	registry.meshPtrs.emplace(entity, &mesh);
 
 	// Setting initial motion values
@@ -1107,6 +1178,7 @@ Entity createBoulder(RenderSystem* renderer, vec2 pos)
 
 	registry.rollables.emplace(entity);
 	registry.boulders.emplace(entity);
+	addCollider(entity, LAYER_BOULDER);
 	registry.preciseColliders.emplace(entity);
 
 	motion.scale = vec2({ ROCK_MESH_WIDTH, -ROCK_MESH_HEIGHT });
@@ -1125,7 +1197,7 @@ Entity createBoulder(RenderSystem* renderer, vec2 pos)
 // create lightning
 Entity createLightning(RenderSystem* renderer, vec2 position, int isFriendly)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	// Store a reference to the potentially re-used mesh object (the value is stored in the resource cache)
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::SPRITE);
@@ -1140,6 +1212,7 @@ Entity createLightning(RenderSystem* renderer, vec2 position, int isFriendly)
 	motion.scale = vec2({ LIGHTNING_WIDTH, LIGHTNING_HEIGHT });
 
 	auto& proj = registry.projectiles.emplace(entity);
+	addCollider(entity, LAYER_PROJECTILE);
 	proj.enableCameraTracking = 0;
 
 	// Set damage here--------------------------------
@@ -1160,7 +1233,7 @@ Entity createLightning(RenderSystem* renderer, vec2 position, int isFriendly)
 
 Entity createMelee(RenderSystem* renderer, vec2 position, int isFriendly)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::SPRITE);
 	registry.meshPtrs.emplace(entity, &mesh);
@@ -1180,6 +1253,7 @@ Entity createMelee(RenderSystem* renderer, vec2 position, int isFriendly)
 	//------------------------------------------------
 
 	registry.projectiles.emplace(entity);
+	addCollider(entity, LAYER_PROJECTILE);
 	registry.renderRequests.insert(
 		entity,
 		{ TEXTURE_ASSET_ID::ROCK,
@@ -1191,7 +1265,7 @@ Entity createMelee(RenderSystem* renderer, vec2 position, int isFriendly)
 
 Entity createBleedDMG(RenderSystem* renderer, vec2 position, int isFriendly)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::SPRITE);
 	registry.meshPtrs.emplace(entity, &mesh);
@@ -1211,6 +1285,7 @@ Entity createBleedDMG(RenderSystem* renderer, vec2 position, int isFriendly)
 	//------------------------------------------------
 
 	registry.projectiles.emplace(entity);
+	addCollider(entity, LAYER_PROJECTILE);
 	registry.renderRequests.insert(
 		entity,
 		{ TEXTURE_ASSET_ID::ROCK,
@@ -1221,9 +1296,9 @@ Entity createBleedDMG(RenderSystem* renderer, vec2 position, int isFriendly)
 }
 
 
-Entity createHealthBar(RenderSystem* renderer, vec2 position)
+Entity createHealthBar(RenderSystem* renderer, vec2 position, Entity owner)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	// Store a reference to the potentially re-used mesh object (the value is stored in the resource cache)
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::SPRITE);
@@ -1243,12 +1318,14 @@ Entity createHealthBar(RenderSystem* renderer, vec2 position)
 		 EFFECT_ASSET_ID::TEXTURED,
 		 GEOMETRY_BUFFER_ID::SPRITE });
 
+	attach(entity, owner);
+
 	return entity;
 }
 
 Entity createSilenceBubble(RenderSystem* renderer, vec2 position)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	// Store a reference to the potentially re-used mesh object (the value is stored in the resource cache)
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::SPRITE);
@@ -1274,7 +1351,7 @@ Entity createSilenceBubble(RenderSystem* renderer, vec2 position)
 
 Entity createParticleBeamCharge(RenderSystem* renderer, vec2 position)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	// Store a reference to the potentially re-used mesh object (the value is stored in the resource cache)
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::SPRITE);
@@ -1295,30 +1372,89 @@ Entity createParticleBeamCharge(RenderSystem* renderer, vec2 position)
 	return entity;
 }
 
+Collider& addCollider(Entity entity, unsigned int layer)
+{
+	Collider& collider = registry.colliders.emplace(entity);
+	collider.category = layer;
+	// The interactions handle_collisions reacts to, the swarm dodges arrows through its own test in step_freeRoam
+	if (layer & LAYER_CHARACTER)
+		collider.mask |= LAYER_PROJECTILE | LAYER_PLATFORM | LAYER_CHEST | LAYER_BOULDER;
+	if (layer & LAYER_PROJECTILE)
+		collider.mask |= LAYER_CHARACTER | LAYER_BOULDER | LAYER_OBSTACLE;
+	if (layer & (LAYER_PLATFORM | LAYER_CHEST))
+		collider.mask |= LAYER_CHARACTER;
+	if (layer & LAYER_BOULDER)
+		collider.mask |= LAYER_CHARACTER | LAYER_PROJECTILE | LAYER_BOULDER;
+	if (layer & LAYER_OBSTACLE)
+		collider.mask |= LAYER_PROJECTILE;
+	return collider;
+}
+
+void attach(Entity child, Entity parent)
+{
+	// A cycle would have no root to place it from
+	for (Entity e = parent; registry.attachments.has(e); e = registry.attachments.get(e).parent)
+		assert(e != child && "Attachment cycle");
+	assert(parent != child && "Attachment cycle");
+
+	Attachment attachment = { parent, { 0.f, 0.f } };
+	if (registry.motions.has(child) && registry.motions.has(parent))
+		attachment.offset = registry.motions.get(child).position - registry.motions.get(parent).position;
+	// Re-inserted rather than modified, so that the registry moves the child to the new parent's list
+	registry.attachments.remove(child);
+	registry.attachments.insert(child, attachment);
+}
+
+void placeCharIndicator(Entity indicator, vec2 position, Entity owner)
+{
+	registry.charIndicator.get(indicator).owner = owner;
+	Motion& motion = registry.motions.get_mut(indicator);
+	motion.position = { position.x, position.y - 150 };
+	// Above the owner at the given height
+	if (registry.motions.has(owner))
+		motion.position.x = registry.motions.get(owner).position.x;
+	attach(indicator, owner);
+}
+
+void setBodyType(Entity entity, BodyType type)
+{
+	RigidBody& body = registry.rigidBodies.has(entity) ? registry.rigidBodies.get_mut(entity) : registry.rigidBodies.emplace(entity);
+	body.type = type;
+}
+
 Entity createLine(vec2 position, vec2 scale)
 {
-	Entity entity = Entity();
+	CommandBuffer commands;
+	Entity entity = createLine(commands, position, scale);
+	commands.flush();
+	return entity;
+}
+
+Entity createLine(CommandBuffer& commands, vec2 position, vec2 scale)
+{
+	Entity entity = commands.create();
 
 	// Store a reference to the potentially re-used mesh object (the value is stored in the resource cache)
-	registry.renderRequests.insert(
+	commands.insert<RenderRequest>(
 		entity,
 		{ TEXTURE_ASSET_ID::TEXTURE_COUNT,
 		 EFFECT_ASSET_ID::PEBBLE,
 		 GEOMETRY_BUFFER_ID::DEBUG_LINE });
 
-	Motion& motion = registry.motions.emplace(entity);
+	Motion motion;
 	motion.angle = 0.f;
 	motion.velocity = { 0, 0 };
 	motion.position = position;
 	motion.scale = scale;
+	commands.insert(entity, motion);
 
-	registry.debugComponents.emplace(entity);
+	commands.emplace<DebugComponent>(entity);
 	return entity;
 }
 
 Entity createDot(RenderSystem* renderer, vec2 position)
 {
-	Entity entity = Entity();
+	Entity entity = registry.create();
 
 	// Store a reference to the potentially re-used mesh object (the value is stored in the resource cache)
 	registry.renderRequests.insert(
@@ -1346,7 +1482,7 @@ void createBackground(RenderSystem* renderer, vec2 pos, int levelNumber)
 	switch (levelNumber) {
 		case TUTORIAL: {
 			for (int i = 0; i < 5; i++) {
-				backgroundEntities.push_back(Entity());
+				backgroundEntities.push_back(registry.create());
 			}
 			bgAssetIds.push_back(TEXTURE_ASSET_ID::TUTORIAL_BG_ONE);
 			bgAssetIds.push_back(TEXTURE_ASSET_ID::TUTORIAL_BG_TWO);
@@ -1356,7 +1492,7 @@ void createBackground(RenderSystem* renderer, vec2 pos, int levelNumber)
 		}
 		case LEVEL_ONE: {
 			for (int i = 0; i < 4; i++) {
-				backgroundEntities.push_back(Entity());
+				backgroundEntities.push_back(registry.create());
 			}
 			bgAssetIds.push_back(TEXTURE_ASSET_ID::LEVEL_ONE_BG_ONE);
 			bgAssetIds.push_back(TEXTURE_ASSET_ID::LEVEL_ONE_BG_TWO);
@@ -1365,7 +1501,7 @@ void createBackground(RenderSystem* renderer, vec2 pos, int levelNumber)
 		}
 		case FREE_ROAM_ONE: {
 			for (int i = 0; i < 5; i++) {
-				backgroundEntities.push_back(Entity());
+				backgroundEntities.push_back(registry.create());
 			}
 			bgAssetIds.push_back(TEXTURE_ASSET_ID::FREE_ROAM_ONE_BG_ONE);
 			bgAssetIds.push_back(TEXTURE_ASSET_ID::FREE_ROAM_ONE_BG_TWO);
@@ -1375,7 +1511,7 @@ void createBackground(RenderSystem* renderer, vec2 pos, int levelNumber)
 		}
 		case LEVEL_TWO: {
 			for (int i = 0; i < 4; i++) {
-				backgroundEntities.push_back(Entity());
+				backgroundEntities.push_back(registry.create());
 			}
 			bgAssetIds.push_back(TEXTURE_ASSET_ID::LEVEL_TWO_BG_ONE);
 			bgAssetIds.push_back(TEXTURE_ASSET_ID::LEVEL_TWO_BG_TWO);
@@ -1384,7 +1520,7 @@ void createBackground(RenderSystem* renderer, vec2 pos, int levelNumber)
 		}
 		case FREE_ROAM_TWO: {
 			for (int i = 0; i < 6; i++) {
-				backgroundEntities.push_back(Entity());
+				backgroundEntities.push_back(registry.create());
 			}
 			bgAssetIds.push_back(TEXTURE_ASSET_ID::FREE_ROAM_TWO_BG_ONE);
 			bgAssetIds.push_back(TEXTURE_ASSET_ID::FREE_ROAM_TWO_BG_TWO);
@@ -1395,7 +1531,7 @@ void createBackground(RenderSystem* renderer, vec2 pos, int levelNumber)
 		}
 		case LEVEL_THREE: {
 			for (int i = 0; i < 1; i++) {
-				backgroundEntities.push_back(Entity());
+				backgroundEntities.push_back(registry.create());
 			}
 			bgAssetIds.push_back(TEXTURE_ASSET_ID::LEVEL_THREE_BG_ONE); break;
 		}
@@ -1430,7 +1566,7 @@ void createBackground(RenderSystem* renderer, vec2 pos, int levelNumber)
 
 Entity createPebble(vec2 pos, vec2 size)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	Motion& motion = registry.motions.emplace(entity);
 	motion.position = pos;
@@ -1439,6 +1575,7 @@ Entity createPebble(vec2 pos, vec2 size)
 	motion.scale = size;
 
 	registry.companions.emplace(entity);
+	addCollider(entity, LAYER_CHARACTER);
 	registry.renderRequests.insert(
 		entity,
 		{ TEXTURE_ASSET_ID::TEXTURE_COUNT, // TEXTURE_COUNT indicates that no txture is needed
@@ -1449,7 +1586,7 @@ Entity createPebble(vec2 pos, vec2 size)
 }
 
 Entity createTutorialBox(RenderSystem* renderer, vec2 position) {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	Motion& motion = registry.motions.emplace(entity);
 	motion.position = position;
@@ -1469,7 +1606,7 @@ Entity createTutorialBox(RenderSystem* renderer, vec2 position) {
 }
 
 Entity createTooltip(RenderSystem* renderer, vec2 position, std::string type) {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	Motion& motion = registry.motions.emplace(entity);
 	motion.position = position;
@@ -1511,7 +1648,7 @@ Entity createTooltip(RenderSystem* renderer, vec2 position, std::string type) {
 }
 
 Entity createUIButton(RenderSystem* renderer, vec2 position, int buttonType) {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	Motion& motion = registry.motions.emplace(entity);
 	motion.position = position;
@@ -1543,12 +1680,14 @@ Entity createUIButton(RenderSystem* renderer, vec2 position, int buttonType) {
 		 EFFECT_ASSET_ID::TEXTURED,
 		 GEOMETRY_BUFFER_ID::SPRITE });
 
+	setBodyType(entity, BodyType::STATIC);
+
 	return entity;
 }
 
 Entity createStoryBackground(RenderSystem* renderer, vec2 pos, int number)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	Motion& motion = registry.motions.emplace(entity);
 	motion.position = pos;
@@ -1593,7 +1732,7 @@ Entity createStoryBackground(RenderSystem* renderer, vec2 pos, int number)
 
 Entity createBackgroundDiaogue(RenderSystem* renderer, vec2 pos, int number)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	Motion& motion = registry.motions.emplace(entity);
 	motion.position = pos;
@@ -1625,7 +1764,7 @@ Entity createBackgroundDiaogue(RenderSystem* renderer, vec2 pos, int number)
 }
 Entity createLevelOneDiaogue(RenderSystem* renderer, vec2 pos, int number)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	Motion& motion = registry.motions.emplace(entity);
 	motion.position = pos;
@@ -1665,7 +1804,7 @@ Entity createLevelOneDiaogue(RenderSystem* renderer, vec2 pos, int number)
 }
 Entity createLevelTwoDiaogue(RenderSystem* renderer, vec2 pos, int number)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	Motion& motion = registry.motions.emplace(entity);
 	motion.position = pos;
@@ -1701,7 +1840,7 @@ Entity createLevelTwoDiaogue(RenderSystem* renderer, vec2 pos, int number)
 }
 Entity createLevelThreeDiaogue(RenderSystem* renderer, vec2 pos, int number)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	Motion& motion = registry.motions.emplace(entity);
 	motion.position = pos;
@@ -1742,7 +1881,7 @@ Entity createLevelThreeDiaogue(RenderSystem* renderer, vec2 pos, int number)
 }
 Entity createLevelFourDiaogue(RenderSystem* renderer, vec2 pos, int number)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	Motion& motion = registry.motions.emplace(entity);
 	motion.position = pos;
@@ -1774,7 +1913,7 @@ Entity createLevelFourDiaogue(RenderSystem* renderer, vec2 pos, int number)
 }
 Entity createFreeRoamLevelDiaogue(RenderSystem* renderer, vec2 pos, int number)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	Motion& motion = registry.motions.emplace(entity);
 	motion.position = pos;
@@ -1812,7 +1951,7 @@ Entity createFreeRoamLevelDiaogue(RenderSystem* renderer, vec2 pos, int number)
 }
 
 Entity createFreeRoamLevelTutorial(RenderSystem* renderer, vec2 pos) {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	Motion& motion = registry.motions.emplace(entity);
 	motion.position = pos;
@@ -1833,7 +1972,7 @@ Entity createFreeRoamLevelTutorial(RenderSystem* renderer, vec2 pos) {
 
 Entity createSizeIndicator(RenderSystem* renderer, vec2 pos, int number)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	Motion& motion = registry.motions.emplace(entity);
 	motion.position = pos;
@@ -1864,7 +2003,7 @@ Entity createSizeIndicator(RenderSystem* renderer, vec2 pos, int number)
 
 Entity createSelectPanel(RenderSystem* renderer, vec2 pos)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	Motion& motion = registry.motions.emplace(entity);
 	motion.position = pos;
@@ -1884,7 +2023,7 @@ Entity createSelectPanel(RenderSystem* renderer, vec2 pos)
 
 Entity createSelections(RenderSystem* renderer, vec2 pos, int number)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	Motion& motion = registry.motions.emplace(entity);
 	motion.position = pos;
@@ -1915,7 +2054,7 @@ Entity createSelections(RenderSystem* renderer, vec2 pos, int number)
 }
 
 Entity createFreeRoamLevelTutorialIndicator(RenderSystem* renderer, vec2 pos) {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	Motion& motion = registry.motions.emplace(entity);
 	motion.position = pos;
@@ -1935,7 +2074,7 @@ Entity createFreeRoamLevelTutorialIndicator(RenderSystem* renderer, vec2 pos) {
 }
 
 Entity createDebuffIndicator(RenderSystem* renderer, vec2 pos) {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	Motion& motion = registry.motions.emplace(entity);
 	motion.position = pos;
@@ -1954,7 +2093,7 @@ Entity createDebuffIndicator(RenderSystem* renderer, vec2 pos) {
 
 Entity createFinishedOptions(RenderSystem* renderer, vec2 pos, int number)
 {
-	auto entity = Entity();
+	auto entity = registry.create();
 
 	Motion& motion = registry.motions.emplace(entity);
 	motion.position = pos;
@@ -3,6 +3,7 @@
 #include "common.hpp"
 #include "tiny_ecs.hpp"
 #include "render_system.hpp"
+#include "command_buffer.hpp"
 
 // These are ahrd coded to the dimensions of the entity texture
 const float MAGE_WIDTH = 175.f / 1.5;
@@ -131,7 +132,7 @@ Entity createNecromancerMinion(RenderSystem* renderer, vec2 pos);
 void createBackground(RenderSystem* renderer, vec2 pos, int levelNumber);
 
 //healthbar
-Entity createHealthBar(RenderSystem* renderer, vec2 position);
+Entity createHealthBar(RenderSystem* renderer, vec2 position, Entity owner);
 // create the silence bubble
 Entity createSilenceBubble(RenderSystem* renderer, vec2 position);
 // create the particle beam charge
@@ -183,8 +184,16 @@ Entity createBoulder(RenderSystem* renderer, vec2 position);
 Entity createMelee(RenderSystem* renderer, vec2 position, int isFriendly);
 // a basic, textured enemy
 Entity createEnemyMage(RenderSystem* renderer, vec2 position);
+// puts the entity on a collision layer, tested against the layers that layer usually interacts with
+Collider& addCollider(Entity entity, unsigned int layer);
+// makes the child follow the parent at its current distance from it, and go when the parent goes
+void attach(Entity child, Entity parent);
+// tells the physics how the entity moves, see BodyType
+void setBodyType(Entity entity, BodyType type);
 // a red line for debugging purposes
 Entity createLine(vec2 position, vec2 size);
+// the same, with its components added on the next flush of 'commands'
+Entity createLine(CommandBuffer& commands, vec2 position, vec2 size);
 
 Entity createTauntIndicator(RenderSystem* renderer, Entity owner);
 
@@ -196,6 +205,8 @@ Entity createTooltip(RenderSystem* renderer, vec2 position, std::string type);
 Entity createBackgroundObject(RenderSystem* renderer, vec2 position);
 
 Entity createCharIndicator(RenderSystem* renderer, vec2 position, Entity owner);
+// Move an existing char indicator above a new owner and attach it there
+void placeCharIndicator(Entity indicator, vec2 position, Entity owner);
 
 Entity createUIButton(RenderSystem* renderer, vec2 position, int buttonType);
 
@@ -468,12 +468,12 @@ void WorldSystem::startMenuCleanUp()
 	renderer->gameLevel = 1;
 				
 	while (registry.motions.entities.size() > 0)
-		registry.remove_all_components_of(registry.motions.entities.back());
+		registry.destroy(registry.motions.entities.back());
 	while (registry.renderRequests.entities.size() > 0)
-		registry.remove_all_components_of(registry.renderRequests.entities.back());
+		registry.destroy(registry.renderRequests.entities.back());
 	if (registry.charIndicator.components.size() != 0)
 	{
-		registry.remove_all_components_of(registry.charIndicator.entities[0]);
+		registry.destroy(registry.charIndicator.entities[0]);
 	}
 	// Debugging for memory/component leaks
 	registry.list_all_components();
@@ -491,7 +491,7 @@ void WorldSystem::render_startscreen()
 	load_game_button = createUIButton(renderer, {850, 330}, LOAD_GAME);
 	makeup_game_button = createUIButton(renderer, {850, 430}, 8);
 	exit_game_button = createUIButton(renderer, {850, 530}, EXIT_GAME);
-	registry.motions.get(exit_game_button).scale = {150, 70};
+	registry.motions.get_mut(exit_game_button).scale = {150, 70};
 }
 
 void WorldSystem::displayPlayerTurn()
@@ -499,8 +499,7 @@ void WorldSystem::displayPlayerTurn()
 	displayTurnIndicator(1);
 	
 	if (registry.charIndicator.has(char_indicator)) {
-		registry.motions.get(char_indicator).position = vec2(CURRPLAYER_LOCATION.x, CURRPLAYER_LOCATION.y - 150);
-		registry.charIndicator.get(char_indicator).owner = currPlayer;
+		placeCharIndicator(char_indicator, CURRPLAYER_LOCATION, currPlayer);
 	}
 	else {
 		char_indicator = createCharIndicator(renderer, CURRPLAYER_LOCATION, currPlayer);
@@ -511,8 +510,7 @@ void WorldSystem::displayEnemyTurn()
 {
 	displayTurnIndicator(0);
 	if (registry.charIndicator.has(char_indicator)) {
-		registry.motions.get(char_indicator).position = vec2(CURRPLAYER_LOCATION.x, CURRPLAYER_LOCATION.y - 150);
-		registry.charIndicator.get(char_indicator).owner = currPlayer;
+		placeCharIndicator(char_indicator, CURRPLAYER_LOCATION, currPlayer);
 	}
 	else {
 		char_indicator = createCharIndicator(renderer, CURRPLAYER_LOCATION, currPlayer);
@@ -528,7 +526,7 @@ void WorldSystem::displayTurnIndicator(int isPlayerTurn)
 	}
 	else
 	{
-		Motion &motion = registry.motions.get(turn_indicator);
+		Motion &motion = registry.motions.get_mut(turn_indicator);
 		RenderRequest &renderRequest = registry.renderRequests.get(turn_indicator);
 		motion.position = TURN_INDICATOR_LOCATION;
 		renderRequest.used_texture = isPlayerTurn ? TEXTURE_ASSET_ID::PLAYER_TURN : TEXTURE_ASSET_ID::ENEMY_TURN;
@@ -543,7 +541,7 @@ void WorldSystem::iceShardAttack(Entity currPlayer)
 	{
 		Motion enemy = registry.motions.get(currPlayer);
 		Entity resultEntity = createIceShard(renderer, {enemy.position.x, enemy.position.y}, 3.14159, {-100, 0}, 0);
-		Motion *ballacc = &registry.motions.get(resultEntity);
+		Motion *ballacc = &registry.motions.get_mut(resultEntity);
 		ballacc->acceleration = vec2(1000 * -100 / ICESHARDSPEED, 1000 * 0 / ICESHARDSPEED);
 		Projectile *proj = &registry.projectiles.get(resultEntity);
 		proj->flyingTimer = 2000.f;
@@ -608,7 +606,7 @@ void WorldSystem::createRound()
 			}
 			else
 			{
-				// registry.remove_all_components_of(entity);
+				// registry.destroy(entity);
 				sk->removeShield(entity);
 			}
 		}
@@ -674,24 +672,18 @@ void WorldSystem::createRound()
 
 	for (int i = 0; i < speedVec.size(); i++)
 	{
-		for (int j = 0; j < registry.companions.components.size(); j++)
-		{
-			Entity &entity = registry.companions.entities[j]; // check companions stats
-			Statistics &checkSpeed = registry.stats.get(entity);
+		registry.view<Companion, Statistics>().each([&](Entity entity, Companion &, Statistics &checkSpeed) { // check companions stats
 			if (speedVec[i] == checkSpeed.speed)
 			{
 				roundVec.push_back(entity); // push to roundVec for use in checkRound
 			}
-		}
-		for (int j = 0; j < registry.enemies.components.size(); j++)
-		{
-			Entity &entity = registry.enemies.entities[j]; // check enemies stats
-			Statistics &checkSpeed = registry.stats.get(entity);
+		});
+		registry.view<Enemy, Statistics>().each([&](Entity entity, Enemy &, Statistics &checkSpeed) { // check enemies stats
 			if (speedVec[i] == checkSpeed.speed)
 			{
 				roundVec.push_back(entity); // push to roundVec for use in checkRound
 			}
-		}
+		});
 	}
 
 	if (extraCompanionTurn <= 0)
@@ -840,8 +832,8 @@ bool WorldSystem::step(float elapsed_ms_since_last_update)
 	glfwSetWindowTitle(window, title_ss.str().c_str());
 
 	// Remove debug info from the last step
-	while (registry.debugComponents.entities.size() > 0)
-		registry.remove_all_components_of(registry.debugComponents.entities.back());
+	for (Entity entity : registry.debugComponents.entities)
+		commands.destroy(entity);
 
 	// Removing out of screen entities
 	auto &motions_registry = registry.motions;
@@ -850,14 +842,13 @@ bool WorldSystem::step(float elapsed_ms_since_last_update)
 	auto &reflects_registry = registry.reflects;
 
 	// Remove entities that leave the screen on the left side
-	// Iterate backwards to be able to remove without unterfering with the next object to visit
-	// (the containers exchange the last element with the current)
-	for (int i = (int)motions_registry.components.size() - 1; i >= 0; --i)
+	// The removal is deferred to the flush below, so the containers can be iterated front to back
+	for (uint i = 0; i < motions_registry.components.size(); i++)
 	{
 		Motion &motion = motions_registry.components[i];
 		if (motion.position.x + abs(motion.scale.x) < 0.f)
 		{
-			registry.remove_all_components_of(motions_registry.entities[i]);
+			commands.destroy(motions_registry.entities[i]);
 		}
 	}
 
@@ -870,9 +861,9 @@ bool WorldSystem::step(float elapsed_ms_since_last_update)
 	}
 	else
 	{
-		for (int j = 0; j < registry.dots.components.size(); j++)
+		for (Entity dot : registry.dots.entities)
 		{
-			registry.remove_all_components_of(registry.dots.entities[j]);
+			commands.destroy(dot);
 		}
 	}
 
@@ -941,27 +932,26 @@ bool WorldSystem::step(float elapsed_ms_since_last_update)
 			Shield *sh = &registry.shield.get(registry.shield.entities[i]);
 			if (sh->shieldDuration < 0)
 			{
-				registry.remove_all_components_of(registry.shield.entities[i]);
+				commands.destroy(registry.shield.entities[i]);
 			}
 		}
 	}
 
-	for (int i = (int)registry.shieldIcons.components.size() - 1; i >= 0; --i)
+	for (uint i = 0; i < registry.shieldIcons.components.size(); i++)
 	{
-
-		ShieldIcon *sh = &registry.shieldIcons.get(registry.shieldIcons.entities[i]);
-		if (sh->shieldDuration <= 0)
+		if (registry.shieldIcons.components[i].shieldDuration <= 0)
 		{
-			registry.remove_all_components_of(registry.shieldIcons.entities[i]);
+			commands.destroy(registry.shieldIcons.entities[i]);
 		}
 	}
+	commands.flush();
 
 	// maintain correct health
 	for (int i = (int)registry.stats.components.size() - 1; i >= 0; --i)
 	{
 		if (registry.stats.components[i].health > registry.stats.components[i].max_health)
 		{
-			Statistics *stat = &registry.stats.components[i];
+			Statistics *stat = &registry.stats.get_mut(registry.stats.entities[i]);
 			stat->health = stat->max_health;
 			update_healthBars();
 		}
@@ -972,7 +962,7 @@ bool WorldSystem::step(float elapsed_ms_since_last_update)
 	//check bouncing arrow
 	for (int i = (int)registry.bouncingArrows.components.size() - 1; i >= 0; --i) {
 		BouncingArrow* ba = &registry.bouncingArrows.components[i];
-		Motion* baM = &registry.motions.get(registry.bouncingArrows.entities[i]);
+		Motion* baM = &registry.motions.get_mut(registry.bouncingArrows.entities[i]);
 		float baXPos = baM->position.x;
 		float baYPos = baM->position.y;
 		//printf("arrowPos: %f %f\n", baXPos, baYPos);
@@ -1099,7 +1089,7 @@ bool WorldSystem::step(float elapsed_ms_since_last_update)
 	// move arrow
 	if (!ArrowResult.empty()) {
 		if (registry.motions.has(currentArrow)) {;
-			Motion* arrowM = &registry.motions.get(currentArrow);
+			Motion* arrowM = &registry.motions.get_mut(currentArrow);
 			arrowM->position = { ArrowResult[0].first*10,ArrowResult[0].second*10 };
 			// assumes ArrowResult will never be empty because arrow disappears before path ends
 			pair<int, int> currpos = ArrowResult[0];
@@ -1133,7 +1123,7 @@ bool WorldSystem::step(float elapsed_ms_since_last_update)
 	for (Entity runner : registry.runners.entities)
 	{
 		RunTowards &run = registry.runners.get(runner);
-		Motion &runner_motion = registry.motions.get(runner);
+		Motion &runner_motion = registry.motions.get_mut(runner);
 		run.counter_ms -= elapsed_ms_since_last_update;
 		if (run.counter_ms <= 0.f)
 		{
@@ -1146,11 +1136,6 @@ bool WorldSystem::step(float elapsed_ms_since_last_update)
 			auto &runner_type = registry.companions.has(runner) ? registry.companions.get(runner).companionType
 																: registry.enemies.get(runner).enemyType;
 
-			Entity healthbar = registry.companions.has(runner) ? registry.companions.get(runner).healthbar
-															   : registry.enemies.get(runner).healthbar;
-			Motion &healthbar_motion = registry.motions.get(healthbar);
-			healthbar_motion.velocity = runner_motion.velocity;
-
 			anim_type = ATTACKING;
 
 			// Attack
@@ -1206,7 +1191,7 @@ bool WorldSystem::step(float elapsed_ms_since_last_update)
 				{
 					printf("Companion is attacking\n");
 					Companion &companion = registry.companions.get(attacker);
-					Motion &companion_motion = registry.motions.get(attacker);
+					Motion &companion_motion = registry.motions.get_mut(attacker);
 					switch (attack.attack_type)
 					{
 					case FIREBALL:
@@ -1224,7 +1209,7 @@ bool WorldSystem::step(float elapsed_ms_since_last_update)
 						sk->launchTaunt(attack.target, renderer);
 						// basiclly to have something hitting the boundary
 						currentProjectile = sk->launchFireball({-20, -20}, {0, 0}, renderer); // TODO: change to new launch dummy projectile without sound
-						Motion *projm = &registry.motions.get(currentProjectile);
+						Motion *projm = &registry.motions.get_mut(currentProjectile);
 						projm->velocity = {-100, 0};
 						projm->acceleration = {-100, 0};
 						break;
@@ -1239,8 +1224,6 @@ bool WorldSystem::step(float elapsed_ms_since_last_update)
 					case MELEE:
 					{
 						companion_motion.position = attack.old_pos;
-						Motion &healthbar_motion = registry.motions.get(companion.healthbar);
-						healthbar_motion.position.x = attack.old_pos.x;
 						sk->launchMelee(attack.target, renderer);
 						break;
 					}
@@ -1259,7 +1242,7 @@ bool WorldSystem::step(float elapsed_ms_since_last_update)
 						update_healthBars();
 						// basiclly to have something hitting the boundary
 						currentProjectile = sk->launchFireball({-20, -20}, {0, 0}, renderer);
-						Motion *projm = &registry.motions.get(currentProjectile);
+						Motion *projm = &registry.motions.get_mut(currentProjectile);
 						projm->velocity = {-100, 0};
 						projm->acceleration = {-100, 0};
 						break;
@@ -1323,10 +1306,8 @@ bool WorldSystem::step(float elapsed_ms_since_last_update)
 					case MELEE:
 					{
 						printf("melee attack enemy\n");
-						Motion &motion = registry.motions.get(attacker);
+						Motion &motion = registry.motions.get_mut(attacker);
 						motion.position = attack.old_pos;
-						Motion &healthbar_motion = registry.motions.get(enemy.healthbar);
-						healthbar_motion.position.x = attack.old_pos.x;
 						sk->launchMelee(attack.target, renderer);
 						break;
 					}
@@ -1372,20 +1353,16 @@ bool WorldSystem::step(float elapsed_ms_since_last_update)
 					}
 					case BLEEDMELEE:
 					{
-						Motion &motion = registry.motions.get(attacker);
+						Motion &motion = registry.motions.get_mut(attacker);
 						motion.position = attack.old_pos;
-						Motion &healthbar_motion = registry.motions.get(enemy.healthbar);
-						healthbar_motion.position.x = attack.old_pos.x;
 						sk->launchMelee(attack.target, renderer);
 						sk->launchBleed(attack.target, renderer);
 						break;
 					}
 					case AOEMELEE:
 					{
-						Motion &motion = registry.motions.get(attacker);
+						Motion &motion = registry.motions.get_mut(attacker);
 						motion.position = attack.old_pos;
-						Motion &healthbar_motion = registry.motions.get(enemy.healthbar);
-						healthbar_motion.position.x = attack.old_pos.x;
 
 						for (Entity e : registry.companions.entities)
 						{
@@ -1500,8 +1477,7 @@ bool WorldSystem::step(float elapsed_ms_since_last_update)
 			{
 				delete[] pool.positions;
 				pool.faded = true;
-				registry.particlePools.remove(entity);
-				registry.remove_all_components_of(entity); // added back in, kinda works
+				commands.destroy(entity);
 			}
 		}
 		else if (pool.areTypeSmoke) {
@@ -1537,8 +1513,7 @@ bool WorldSystem::step(float elapsed_ms_since_last_update)
 			{
 				delete[] pool.positions;
 				pool.faded = true;
-				registry.particlePools.remove(entity);
-				registry.remove_all_components_of(entity); // added back in, kinda works
+				commands.destroy(entity);
 			}
 		}
 		else
@@ -1554,19 +1529,21 @@ bool WorldSystem::step(float elapsed_ms_since_last_update)
 			{
 				for (Entity entity : registry.companions.entities)
 				{
-					Statistics &stat = registry.stats.get(entity);
+					Statistics &stat = registry.stats.get_mut(entity);
 					stat.health -= 0.0001;
 					if (stat.health > 0)
 					{
 						Companion &companion = registry.companions.get(entity);
 						Entity healthbar = companion.healthbar;
-						Motion &motion = registry.motions.get(healthbar);
+						Motion &motion = registry.motions.get_mut(healthbar);
 						motion.scale = vec2({(HEALTHBAR_WIDTH * (stat.health / 100.f)), HEALTHBAR_HEIGHT});
 					}
 				}
 			}
 		}
 	}
+	// Faded particle pools
+	commands.flush();
 
 	if(isFreeRoam && (freeRoamLevel == 1) && (!isMakeupGame)){
 		next_boulder_spawn -= elapsed_ms_since_last_update * current_speed;
@@ -1576,13 +1553,13 @@ bool WorldSystem::step(float elapsed_ms_since_last_update)
 			// Create boulder
 			Entity entity = createBoulder(renderer, {window_width_px+50, window_height_px - ARCHER_FREEROAM_HEIGHT + 25});
 			// Setting random initial position and constant velocity
-			Motion& motion = registry.motions.get(entity);
+			Motion& motion = registry.motions.get_mut(entity);
 			motion.acceleration = vec2(BOULDER_ACCELERATION, 0.f);
 			motion.velocity = vec2(BOULDER_VELOCITY, 0.f);
 		}
 		// move it to physics
 		for(Entity rollable: registry.rollables.entities){
-			Motion& motion = registry.motions.get(rollable);
+			Motion& motion = registry.motions.get_mut(rollable);
 			motion.angle = motion.angle - 0.03;
 		}
 	}
@@ -1643,11 +1620,11 @@ bool WorldSystem::step(float elapsed_ms_since_last_update)
 			{
 				if (registry.companions.has(entity))
 				{
-					registry.motions.get(entity).position.x += hit_position;
+					registry.motions.get_mut(entity).position.x += hit_position;
 				}
 				else
 				{
-					registry.motions.get(entity).position.x -= hit_position;
+					registry.motions.get_mut(entity).position.x -= hit_position;
 				}
 			}
 			return true;
@@ -1677,7 +1654,7 @@ bool WorldSystem::step(float elapsed_ms_since_last_update)
 
 	// update state of free_roam_bird
 	if (registry.motions.has(free_roam_bird)) {
-		auto& birdMotion = registry.motions.get(free_roam_bird);
+		auto& birdMotion = registry.motions.get_mut(free_roam_bird);
 		registry.bird.get(free_roam_bird).birdNextPostionTracker = birdNextPostionTracker;
 
 		if (birdPositionDivisor == 1 || birdPositionDivisor == 2) {
@@ -1842,16 +1819,27 @@ void WorldSystem::restart_game(bool force_restart)
 	// Reset the game speed
 	current_speed = 1.f;
 
+	// Remember how much the level we leave needed, so that the next load of it can reserve it up front
+	if (!capacity_profile_level.empty())
+		json_loader.save_capacity_profile(capacity_profile_level, registry.capacity_profile());
+
 	// Remove all entities that we created
 	// All that have a motion, we could also iterate over all fish, turtles, ... but that would be more cumbersome
 	while (registry.motions.entities.size() > 0)
-		registry.remove_all_components_of(registry.motions.entities.back());
+		registry.destroy(registry.motions.entities.back());
 	while (registry.renderRequests.entities.size() > 0)
-		registry.remove_all_components_of(registry.renderRequests.entities.back());
+		registry.destroy(registry.renderRequests.entities.back());
 
 	// Debugging for memory/component leaks
 	registry.list_all_components();
 
+	// Reserve the capacities recorded on the last run of the level before creating its entities
+	capacity_profile_level = isFreeRoam ? "free_roam_" + std::to_string(freeRoamLevel) : "level_" + std::to_string(gameLevel);
+	registry.reserve(json_loader.get_capacity_profile(capacity_profile_level));
+
+	// Levels that want a particular collision grid set it in their file
+	collisionCellSize = 0.f;
+
 	int w, h;
 	glfwGetWindowSize(window, &w, &h);
 	// Render background before all else
@@ -1998,7 +1986,7 @@ void WorldSystem::update_health(Entity entity, Entity other_entity)
 			{
 				Enemy &enemy = registry.enemies.get(other_entity);
 				healthbar = enemy.healthbar;
-				hp = &registry.stats.get(other_entity);
+				hp = &registry.stats.get_mut(other_entity);
 			}
 		}
 		else
@@ -2007,7 +1995,7 @@ void WorldSystem::update_health(Entity entity, Entity other_entity)
 			{
 				Companion &companion = registry.companions.get(other_entity);
 				healthbar = companion.healthbar;
-				hp = &registry.stats.get(other_entity);
+				hp = &registry.stats.get_mut(other_entity);
 			}
 		}
 		if (hp)
@@ -2015,7 +2003,7 @@ void WorldSystem::update_health(Entity entity, Entity other_entity)
 			//hp->health = hp->health - (rand() % damage.range + damage.minDamage);
 			// No randomness in damage
 			hp->health = hp->health - damage.minDamage;
-			Motion &motion = registry.motions.get(healthbar);
+			Motion &motion = registry.motions.get_mut(healthbar);
 			if (registry.stats.get(currPlayer).health <= 0)
 			{ // check if HP of currPlayer is 0, checkRound to skip this player
 				if (!registry.deathTimers.has(other_entity))
@@ -2085,32 +2073,22 @@ void WorldSystem::update_health(Entity entity, Entity other_entity)
 
 void WorldSystem::update_healthBars()
 {
-	for (Entity entity : registry.enemies.entities)
-	{
-		if (!registry.enemies.has(entity) || !registry.stats.has(entity)) continue;
-
-		Enemy &enemy = registry.enemies.get(entity);
-		Statistics &stat = registry.stats.get(entity);
-		Entity healthbar = enemy.healthbar;
-
-		if (!registry.motions.has(healthbar)) continue;
-
-		Motion &motion = registry.motions.get(healthbar);
-		motion.scale = vec2({(HEALTHBAR_WIDTH * (stat.health / 100.f)), HEALTHBAR_HEIGHT});
-	}
-	for (Entity entity : registry.companions.entities)
-	{
-		if (!registry.companions.has(entity) || !registry.stats.has(entity)) continue;
-
-		Companion &enemy = registry.companions.get(entity);
-		Statistics &stat = registry.stats.get(entity);
-		Entity healthbar = enemy.healthbar;
+	// Only the statistics that changed since the last update can have a different health bar
+	registry.stats.each_changed(healthbar_tick, [](Entity entity, Statistics &stat) {
+		Entity healthbar;
+		if (registry.enemies.has(entity))
+			healthbar = registry.enemies.get(entity).healthbar;
+		else if (registry.companions.has(entity))
+			healthbar = registry.companions.get(entity).healthbar;
+		else
+			return;
 
-		if (!registry.motions.has(healthbar)) continue;
+		if (!registry.motions.has(healthbar)) return;
 
-		Motion &motion = registry.motions.get(healthbar);
+		Motion &motion = registry.motions.get_mut(healthbar);
 		motion.scale = vec2({(HEALTHBAR_WIDTH * (stat.health / 100.f)), HEALTHBAR_HEIGHT});
-	}
+	});
+	healthbar_tick = registry.stats.current_tick();
 }
 
 void WorldSystem::activate_deathParticles(Entity entity)
@@ -2121,10 +2099,11 @@ void WorldSystem::activate_deathParticles(Entity entity)
 	initParticlesBuffer(pool);
 	pool.poolLife = 2000.f;
 	pool.motion.scale = vec2(10.f, 10.f);
+	pool.particles.reserve(pool.size);
 
 	for (int p = 0; p < pool.size; p++)
 	{
-		auto &motion = registry.motions.get(entity);
+		auto &motion = registry.motions.get_mut(entity);
 		Particle particle;
 		float random1 = ((rand() % 100) - 50) / 10.0f;
 		float random2 = ((rand() % 200) - 100) / 10.0f;
@@ -2153,10 +2132,11 @@ void WorldSystem::activate_smokeParticles(Entity entity)
 	initParticlesBuffer(pool);
 	pool.poolLife = 2000.f;
 	pool.motion.scale = vec2(3.f, 3.f);
+	pool.particles.reserve(pool.size);
 
 	for (int p = 0; p < pool.size; p++)
 	{
-		auto& motion = registry.motions.get(entity);
+		auto& motion = registry.motions.get_mut(entity);
 		Particle particle;
 		float random1 = ((rand() % 100) - 50) / 10.0f;
 		float random2 = ((rand() % 200) - 100) / 10.0f;
@@ -2189,12 +2169,19 @@ void WorldSystem::handle_collisions()
 	currCeilingPos = 0.f;
 	currFloorPos = window_height_px - ARCHER_FREEROAM_HEIGHT + 25;
 
-	auto &collisionsRegistry = registry.collisions;
-	for (uint i = 0; i < collisionsRegistry.components.size(); i++)
+	// One event per touching pair, handled from the side of each of its two entities
+	// One-off reactions (hits, opening chests) happen when a contact begins, pushing against platforms and
+	// boulders lasts while it stays. Nothing reacts to a contact ending yet.
+	for (uint i = 0; i < 2 * registry.contacts.size(); i++)
 	{
+		const Contact& contact = registry.contacts[i / 2];
+		if (contact.phase == ContactPhase::END)
+			continue;
+		bool begins = contact.phase == ContactPhase::BEGIN;
+
 		// The entity and its collider
-		Entity entity = collisionsRegistry.entities[i];
-		Entity entity_other = collisionsRegistry.components[i].other;
+		Entity entity = i % 2 == 0 ? contact.a : contact.b;
+		Entity entity_other = i % 2 == 0 ? contact.b : contact.a;
 
 		// deal with collisions in free roam
 		if (isFreeRoam) {
@@ -2211,7 +2198,7 @@ void WorldSystem::handle_collisions()
 					float platform_width = platform_motion.scale.x;
 					float platform_height = platform_motion.scale.y;
 
-					Motion& archer_motion = registry.motions.get(player_archer);
+					Motion& archer_motion = registry.motions.get_mut(player_archer);
 					float archer_pos_x = archer_motion.position.x;
 					float archer_pos_y = archer_motion.position.y;
 
@@ -2240,7 +2227,7 @@ void WorldSystem::handle_collisions()
 					}
 				}
 				// Deal with archer - treasure chest collisions
-				else if (registry.chests.has(entity_other)) {;
+				else if (begins && registry.chests.has(entity_other)) {;
 					TreasureChest chest = registry.chests.get(entity_other);
 					RenderRequest& renderedChest = registry.renderRequests.get(entity_other);
 					Motion chestMotion = registry.motions.get(entity_other);
@@ -2263,7 +2250,7 @@ void WorldSystem::handle_collisions()
 				// Rock archer collision
 				else if (registry.boulders.has(entity_other) && !registry.particlePools.has(entity_other))
 				{
-					Motion& rollable_motion = registry.motions.get(entity_other);
+					Motion& rollable_motion = registry.motions.get_mut(entity_other);
 					rollable_motion.velocity = { BOULDER_VELOCITY / 3, 0.f};
 
 					float rock_pos_x = rollable_motion.position.x;
@@ -2271,7 +2258,7 @@ void WorldSystem::handle_collisions()
 					float rock_width = rollable_motion.scale.x;
 					float rock_height = abs(rollable_motion.scale.y);
 
-					Motion& archer_motion = registry.motions.get(player_archer);
+					Motion& archer_motion = registry.motions.get_mut(player_archer);
 					float archer_pos_x = archer_motion.position.x;
 					float archer_pos_y = archer_motion.position.y;
 
@@ -2296,8 +2283,8 @@ void WorldSystem::handle_collisions()
 			}
 
 			if (registry.boulders.has(entity) && registry.boulders.has(entity_other)) {
-				Motion& entity_motion = registry.motions.get(entity);
-				Motion& entity_other_motion = registry.motions.get(entity_other);
+				Motion& entity_motion = registry.motions.get_mut(entity);
+				Motion& entity_other_motion = registry.motions.get_mut(entity_other);
 
 				if (entity_motion.position.x < entity_other_motion.position.x) {
 					entity_motion.velocity = vec2(BOULDER_VELOCITY * 1.5, 0.f);
@@ -2311,20 +2298,20 @@ void WorldSystem::handle_collisions()
 			}
 
 			// Deal with arrow - bird collisions
-			if (registry.projectiles.has(entity))
+			if (begins && registry.projectiles.has(entity))
 			{
 				// Checking bird
 				if (registry.bird.has(entity_other))
 				{
-					registry.remove_all_components_of(entity_other);
-					registry.remove_all_components_of(entity);
+					registry.destroy(entity_other);
+					registry.destroy(entity);
 					Mix_PlayChannel(-1, registry.crow_sound, 0);
 				}
 				// Arrow rock collision
 				else if (registry.boulders.has(entity_other) && !registry.particlePools.has(entity_other)) {
 					Mix_PlayChannel(-1, registry.fireball_explosion_sound, 0);
 					activate_deathParticles(entity_other);
-					registry.remove_all_components_of(entity);
+					registry.destroy(entity);
 				}
 			}
 		}		
@@ -2333,12 +2320,12 @@ void WorldSystem::handle_collisions()
 		else {
 			//printf("Not free world\n");
 			// Deal with arrow - bird collisions
-			if (registry.projectiles.has(entity))	// not working in free roam
+			if (begins && registry.projectiles.has(entity))	// not working in free roam
 			{
 				// Checking bird
 				if (registry.bird.has(entity_other))
 				{
-					registry.remove_all_components_of(entity_other);
+					registry.destroy(entity_other);
 					Mix_PlayChannel(-1, registry.crow_sound, 0);
 				}
 			}
@@ -2346,7 +2333,7 @@ void WorldSystem::handle_collisions()
 			if (registry.companions.has(entity))
 			{
 				// Checking Projectile - Companion collisions
-				if (registry.projectiles.has(entity_other))
+				if (begins && registry.projectiles.has(entity_other))
 				{
 
 					Damage& projDamage = registry.damages.get(entity_other);
@@ -2358,7 +2345,7 @@ void WorldSystem::handle_collisions()
 							if (!registry.buttons.has(entity))
 							{
 								update_health(entity_other, entity);
-								registry.remove_all_components_of(entity_other);
+								registry.destroy(entity_other);
 								Mix_PlayChannel(-1, registry.fireball_explosion_sound, 0); // added fireball hit sound
 								showCorrectSkills();
 								if (registry.stats.has(entity) && registry.stats.get(entity).health <= 0)
@@ -2372,7 +2359,7 @@ void WorldSystem::handle_collisions()
 								// update only if hit_timer for entity does not already exist
 								if (!registry.hit_timer.has(entity))
 								{
-									registry.motions.get(entity).position.x -= 20; // character shifts backwards
+									registry.motions.get_mut(entity).position.x -= 20; // character shifts backwards
 									registry.hit_timer.emplace(entity);			   // to move character back to original position
 								}
 								// displayPlayerTurn();	// displays player turn when enemy hits collide
@@ -2404,7 +2391,7 @@ void WorldSystem::handle_collisions()
 			else if (registry.enemies.has(entity))
 			{
 				// Checking Projectile - Enemy collisions
-				if (registry.projectiles.has(entity_other))
+				if (begins && registry.projectiles.has(entity_other))
 				{
 					if (registry.FireBalls.has(entity_other)) {
 						activate_smokeParticles(entity_other);
@@ -2418,7 +2405,7 @@ void WorldSystem::handle_collisions()
 							if (!registry.buttons.has(entity))
 							{
 								update_health(entity_other, entity);
-								registry.remove_all_components_of(entity_other);
+								registry.destroy(entity_other);
 								Mix_PlayChannel(-1, registry.fireball_explosion_sound, 0); // added fireball hit sound
 								if (registry.stats.has(entity) && registry.stats.get(entity).health <= 0)
 								{
@@ -2435,7 +2422,7 @@ void WorldSystem::handle_collisions()
 								// update only if hit_timer for entity does not already exist
 								if (!registry.hit_timer.has(entity))
 								{
-									registry.motions.get(entity).position.x += 20; // character shifts backwards
+									registry.motions.get_mut(entity).position.x += 20; // character shifts backwards
 									registry.hit_timer.emplace(entity);			   // to move character back to original position
 								}
 								// enemy turn start
@@ -2464,12 +2451,12 @@ void WorldSystem::handle_collisions()
 				}
 			}
 			// handle collisions with background objects
-			if (registry.deformableEntities.has(entity) && registry.projectiles.has(entity_other) && !registry.reflects.has(entity))
+			if (begins && registry.deformableEntities.has(entity) && registry.projectiles.has(entity_other) && !registry.reflects.has(entity))
 			{
 				auto& backgroundObj = registry.deformableEntities.get(entity);
 				backgroundObj.shouldDeform = true;
 				Mix_PlayChannel(-1, registry.fireball_explosion_sound, 0);
-				registry.remove_all_components_of(entity_other);
+				registry.destroy(entity_other);
 				// enemy turn start
 				if (player_turn == 0)
 				{
@@ -2492,7 +2479,7 @@ void WorldSystem::handle_collisions()
 				}
 			}
 			// barrier collection
-			else if (registry.projectiles.has(entity))
+			else if (begins && registry.projectiles.has(entity))
 			{
 				if (registry.reflects.has(entity_other))
 				{
@@ -2505,7 +2492,7 @@ void WorldSystem::handle_collisions()
 						shieldMesh.shouldDeform = true;
 						shieldMesh.deformType2 = true;
 
-						Motion* reflectEM = &registry.motions.get(entity);
+						Motion* reflectEM = &registry.motions.get_mut(entity);
 
 						reflectEM->velocity = vec2(-registry.motions.get(entity).velocity.x, reflectEM->velocity.y);
 						reflectEM->acceleration = vec2(-registry.motions.get(entity).acceleration.x, reflectEM->acceleration.y);
@@ -2523,7 +2510,7 @@ void WorldSystem::handle_collisions()
 
 	if(isFreeRoam){
 
-		Motion& archerMotion = registry.motions.get(player_archer);
+		Motion& archerMotion = registry.motions.get_mut(player_archer);
 
 		// Check if archer is above ceiling
 		if (archerMotion.position.y < currCeilingPos) {
@@ -2552,8 +2539,8 @@ void WorldSystem::handle_collisions()
 		}
 	}
 
-	// Remove all collisions from this simulation step
-	registry.collisions.clear();
+	// Remove all contacts from this simulation step
+	registry.contacts.clear();
 }
 
 void WorldSystem::handle_boundary_collision()
@@ -2575,15 +2562,15 @@ void WorldSystem::handle_boundary_collision()
 					continue;
 				} 
 			}
-			registry.remove_all_components_of(entity);
-			registry.remove_all_components_of(entity);
+			registry.destroy(entity);
+			registry.destroy(entity);
 			Mix_PlayChannel(-1, registry.fireball_explosion_sound, 0);
 			// enemy turn start
 		}
 	}
 	if(isFreeRoam){
 
-		Motion& archerMotion = registry.motions.get(player_archer);
+		Motion& archerMotion = registry.motions.get_mut(player_archer);
 
 		// Check for left & right boundaries
 		if (archerMotion.position.x < ARCHER_FREEROAM_WIDTH / 2) {
@@ -2619,7 +2606,7 @@ void WorldSystem::on_key(int key, int, int action, int mod)
 		if (key == GLFW_KEY_H) {
 			if (action == GLFW_RELEASE) {
 				if (registry.renderRequests.has(free_roam_tutorial)) {
-					registry.remove_all_components_of(free_roam_tutorial);
+					registry.destroy(free_roam_tutorial);
 				}
 				else {
 					free_roam_tutorial = createFreeRoamLevelTutorial(renderer, vec2(window_width_px / 2, window_height_px / 2));
@@ -2633,7 +2620,7 @@ void WorldSystem::on_key(int key, int, int action, int mod)
 		// Move right
 		if (key == GLFW_KEY_D) {
 			if ((action == GLFW_PRESS) || (action == GLFW_REPEAT)) {
-				Motion& motion = registry.motions.get(player_archer);
+				Motion& motion = registry.motions.get_mut(player_archer);
 				motion.velocity.x = 400.f;
 				// Turn archer right
 				if (registry.companions.get(player_archer).curr_anim_type != ATTACKING
@@ -2647,7 +2634,7 @@ void WorldSystem::on_key(int key, int, int action, int mod)
 				}
 			}
 			if (action == GLFW_RELEASE) {
-				Motion& motion = registry.motions.get(player_archer);
+				Motion& motion = registry.motions.get_mut(player_archer);
 				if (motion.velocity.x != -400.f) {
 					motion.velocity.x = 0;
 					if (registry.companions.get(player_archer).curr_anim_type != JUMPING
@@ -2661,7 +2648,7 @@ void WorldSystem::on_key(int key, int, int action, int mod)
 		// Move left
 		if (key == GLFW_KEY_A) {
 			if ((action == GLFW_PRESS) || (action == GLFW_REPEAT)) {
-				Motion& motion = registry.motions.get(player_archer);
+				Motion& motion = registry.motions.get_mut(player_archer);
 				motion.velocity.x = -400.f;
 				// Turn archer left
 				if (registry.companions.get(player_archer).curr_anim_type != ATTACKING
@@ -2675,7 +2662,7 @@ void WorldSystem::on_key(int key, int, int action, int mod)
 				}	
 			}
 			if (action == GLFW_RELEASE) {
-				Motion& motion = registry.motions.get(player_archer);
+				Motion& motion = registry.motions.get_mut(player_archer);
 				if (motion.velocity.x != 400.f) {
 					motion.velocity.x = 0;
 					if (registry.companions.get(player_archer).curr_anim_type != JUMPING
@@ -2691,7 +2678,7 @@ void WorldSystem::on_key(int key, int, int action, int mod)
 			&& registry.companions.get(player_archer).curr_anim_type != ATTACKING
 			&& registry.companions.get(player_archer).curr_anim_type != WALK_ATTACKING) {
 			if (action == GLFW_RELEASE) {
-				Motion& motion = registry.motions.get(player_archer);
+				Motion& motion = registry.motions.get_mut(player_archer);
 				motion.velocity.y = -(registry.verticalResolution / 2.25);
 				registry.companions.get(player_archer).curr_anim_type = JUMPING;
 			}
@@ -2707,6 +2694,8 @@ void WorldSystem::on_key(int key, int, int action, int mod)
 		else
 			debugging.in_debug_mode = true;
 	}
+	if (action == GLFW_RELEASE && key == GLFW_KEY_T)
+		debugging.dump_telemetry = true;
 
 	// Volume control (z = Decrease BGM vol., x = Increase BGM vol., c = Decrease effects vol., v = Increase effects vol.)
 	if (action == GLFW_RELEASE && key == GLFW_KEY_Z)
@@ -2823,9 +2812,9 @@ void WorldSystem::on_mouse_button(int button, int action, int mods)
 		Mix_PlayChannel(5, registry.turning_sound, 0);
 		int w, h;
 		glfwGetWindowSize(window, &w, &h);
-		registry.remove_all_components_of(backgroundImage);
+		registry.destroy(backgroundImage);
 		backgroundImage = createStoryBackground(renderer, {window_width_px / 2, window_height_px / 2}, 2);
-		registry.remove_all_components_of(dialogue);
+		registry.destroy(dialogue);
 		dialogue = createBackgroundDiaogue(renderer, {window_width_px / 2, 650}, 2);
 		story = 2;
 	}
@@ -2835,7 +2824,7 @@ void WorldSystem::on_mouse_button(int button, int action, int mods)
 		Mix_PlayChannel(5, registry.turning_sound, 0);
 		int w, h;
 		glfwGetWindowSize(window, &w, &h);
-		registry.remove_all_components_of(dialogue);
+		registry.destroy(dialogue);
 		dialogue = createBackgroundDiaogue(renderer, {window_width_px / 2, 650}, 3);
 		story = 3;
 	}
@@ -2845,9 +2834,9 @@ void WorldSystem::on_mouse_button(int button, int action, int mods)
 		Mix_PlayChannel(5, registry.turning_sound, 0);
 		int w, h;
 		glfwGetWindowSize(window, &w, &h);
-		registry.remove_all_components_of(backgroundImage);
+		registry.destroy(backgroundImage);
 		backgroundImage = createStoryBackground(renderer, {window_width_px / 2, window_height_px / 2}, 3);
-		registry.remove_all_components_of(dialogue);
+		registry.destroy(dialogue);
 		dialogue = createBackgroundDiaogue(renderer, {window_width_px / 2, 650}, 4);
 		story = 4;
 	}
@@ -2857,9 +2846,9 @@ void WorldSystem::on_mouse_button(int button, int action, int mods)
 		Mix_PlayChannel(5, registry.turning_sound, 0);
 		int w, h;
 		glfwGetWindowSize(window, &w, &h);
-		registry.remove_all_components_of(backgroundImage);
+		registry.destroy(backgroundImage);
 		backgroundImage = createStoryBackground(renderer, {w / 2, h / 2}, 4);
-		registry.remove_all_components_of(dialogue);
+		registry.destroy(dialogue);
 		story = 5;
 	}
 	else if (button == GLFW_MOUSE_BUTTON_LEFT && action == GLFW_RELEASE && !canStep && story == 5 && dragon == 0)
@@ -2877,8 +2866,8 @@ void WorldSystem::on_mouse_button(int button, int action, int mods)
 		Mix_PlayChannel(5, registry.turning_sound, 0);
 		int w, h;
 		glfwGetWindowSize(window, &w, &h);
-		registry.remove_all_components_of(dialogue);
-		registry.remove_all_components_of(backgroundImage);
+		registry.destroy(dialogue);
+		registry.destroy(backgroundImage);
 		backgroundImage = createStoryBackground(renderer, {w / 2, h / 2}, 5);
 		story = 7;
 	}
@@ -2895,7 +2884,7 @@ void WorldSystem::on_mouse_button(int button, int action, int mods)
 	}
 	else if (button == GLFW_MOUSE_BUTTON_LEFT && action == GLFW_RELEASE && !canStep && story >= 8 && story <= 17 && dragon == 0)
 	{
-		registry.remove_all_components_of(dialogue);
+		registry.destroy(dialogue);
 		printf("STORY IS WHAT NUMBER: %g \n", float(story));
 		dialogue = createLevelOneDiaogue(renderer, { window_width_px / 2, window_height_px - window_height_px / 3 }, (story - 7));
 		story++;
@@ -2908,7 +2897,7 @@ void WorldSystem::on_mouse_button(int button, int action, int mods)
 	}
 	else if (button == GLFW_MOUSE_BUTTON_LEFT && action == GLFW_RELEASE && !canStep && story >= 19 && story <= 24 && dragon == 0)
 	{
-		registry.remove_all_components_of(dialogue);
+		registry.destroy(dialogue);
 		printf("STORY IS WHAT NUMBER: %g \n", float(story));
 		dialogue = createLevelTwoDiaogue(renderer, { window_width_px / 2, window_height_px - window_height_px / 3 }, (story - 18));
 		story++;
@@ -2921,14 +2910,14 @@ void WorldSystem::on_mouse_button(int button, int action, int mods)
 	}
 	else if (button == GLFW_MOUSE_BUTTON_LEFT && action == GLFW_RELEASE && !canStep && story >= 26 && story <= 32 && dragon == 0)
 	{
-		registry.remove_all_components_of(dialogue);
+		registry.destroy(dialogue);
 		printf("STORY IS WHAT NUMBER: %g \n", float(story));
 		dialogue = createLevelThreeDiaogue(renderer, { window_width_px / 2, window_height_px - window_height_px / 3 }, (story - 24));
 		story++;
 	}
 	else if (button == GLFW_MOUSE_BUTTON_LEFT && action == GLFW_RELEASE && !canStep && story == 33)
 	{
-		registry.remove_all_components_of(dialogue);
+		registry.destroy(dialogue);
 		canStep = 1;
 		story = 36;
 		roundVec.clear(); // empty vector roundVec to create a new round
@@ -2942,7 +2931,7 @@ void WorldSystem::on_mouse_button(int button, int action, int mods)
 	}
 	else if (button == GLFW_MOUSE_BUTTON_LEFT && action == GLFW_RELEASE && !canStep && story >= 36 && story <= 39 && dragon == 0)
 	{
-		registry.remove_all_components_of(dialogue);
+		registry.destroy(dialogue);
 		dialogue = createLevelFourDiaogue(renderer, { window_width_px / 2, window_height_px - window_height_px / 3 }, (story - 35));
 		story++;
 	}
@@ -2952,12 +2941,12 @@ void WorldSystem::on_mouse_button(int button, int action, int mods)
 
 		// GO TO CONCLUSION
 		while (registry.motions.entities.size() > 0) {
-			registry.remove_all_components_of(registry.motions.entities.back());
+			registry.destroy(registry.motions.entities.back());
 		}
 		int w, h;
 		glfwGetWindowSize(window, &w, &h);
-		registry.remove_all_components_of(dialogue);
-		registry.remove_all_components_of(backgroundImage);
+		registry.destroy(dialogue);
+		registry.destroy(backgroundImage);
 		backgroundImage = createStoryBackground(renderer, { w / 2, h / 2 }, 11);
 	}
 	else if (button == GLFW_MOUSE_BUTTON_LEFT && action == GLFW_RELEASE && !canStep && story == 42)
@@ -2966,8 +2955,8 @@ void WorldSystem::on_mouse_button(int button, int action, int mods)
 		Mix_PlayChannel(5, registry.turning_sound, 0);
 		int w, h;
 		glfwGetWindowSize(window, &w, &h);
-		registry.remove_all_components_of(dialogue);
-		registry.remove_all_components_of(backgroundImage);
+		registry.destroy(dialogue);
+		registry.destroy(backgroundImage);
 		backgroundImage = createStoryBackground(renderer, { w / 2, h / 2 }, 12);
 		story++;
 	}
@@ -2977,8 +2966,8 @@ void WorldSystem::on_mouse_button(int button, int action, int mods)
 		Mix_PlayChannel(5, registry.turning_sound, 0);
 		int w, h;
 		glfwGetWindowSize(window, &w, &h);
-		registry.remove_all_components_of(dialogue);
-		registry.remove_all_components_of(backgroundImage);
+		registry.destroy(dialogue);
+		registry.destroy(backgroundImage);
 		backgroundImage = createStoryBackground(renderer, { w / 2, h / 2 }, 13);
 		story++;
 	}
@@ -2988,8 +2977,8 @@ void WorldSystem::on_mouse_button(int button, int action, int mods)
 		Mix_PlayChannel(5, registry.turning_sound, 0);
 		int w, h;
 		glfwGetWindowSize(window, &w, &h);
-		registry.remove_all_components_of(dialogue);
-		registry.remove_all_components_of(backgroundImage);
+		registry.destroy(dialogue);
+		registry.destroy(backgroundImage);
 		backgroundImage = createStoryBackground(renderer, { w / 2, h / 2 }, 14);
 		story++;
 	}
@@ -2999,8 +2988,8 @@ void WorldSystem::on_mouse_button(int button, int action, int mods)
 		Mix_PlayChannel(5, registry.turning_sound, 0);
 		int w, h;
 		glfwGetWindowSize(window, &w, &h);
-		registry.remove_all_components_of(dialogue);
-		registry.remove_all_components_of(backgroundImage);
+		registry.destroy(dialogue);
+		registry.destroy(backgroundImage);
 		backgroundImage = createStoryBackground(renderer, { w / 2, h / 2 }, 15);
 		story++;
 	}
@@ -3010,8 +2999,8 @@ void WorldSystem::on_mouse_button(int button, int action, int mods)
 		Mix_PlayChannel(5, registry.turning_sound, 0);
 		int w, h;
 		glfwGetWindowSize(window, &w, &h);
-		registry.remove_all_components_of(dialogue);
-		registry.remove_all_components_of(backgroundImage);
+		registry.destroy(dialogue);
+		registry.destroy(backgroundImage);
 		backgroundImage = createStoryBackground(renderer, { w / 2, h / 2 }, 16);
 		story++;
 	}
@@ -3021,8 +3010,8 @@ void WorldSystem::on_mouse_button(int button, int action, int mods)
 		Mix_PlayChannel(5, registry.turning_sound, 0);
 		int w, h;
 		glfwGetWindowSize(window, &w, &h);
-		registry.remove_all_components_of(dialogue);
-		registry.remove_all_components_of(backgroundImage);
+		registry.destroy(dialogue);
+		registry.destroy(backgroundImage);
 		backgroundImage = createStoryBackground(renderer, { w / 2, h / 2 }, 17);
 		story++;
 	}
@@ -3045,60 +3034,60 @@ void WorldSystem::on_mouse_button(int button, int action, int mods)
 
 	else if (button == GLFW_MOUSE_BUTTON_LEFT && action == GLFW_RELEASE && (beginning == 1 || beginning == 2) && dragon == 0)
 	{
-		registry.remove_all_components_of(dialogue);
+		registry.destroy(dialogue);
 		beginning = 0;
 	}
 	else if (button == GLFW_MOUSE_BUTTON_LEFT && action == GLFW_RELEASE && beginning >= 3 && beginning <= 5)
 	{
-		registry.remove_all_components_of(dialogue);
+		registry.destroy(dialogue);
 		dialogue = createLevelThreeDiaogue(renderer, { window_width_px / 2, window_height_px - window_height_px / 3 }, (beginning + 7));
 		beginning++;
 	}
 	else if (button == GLFW_MOUSE_BUTTON_LEFT && action == GLFW_RELEASE && beginning == 6 && dragon == 0)
 	{
-		registry.remove_all_components_of(dialogue);
+		registry.destroy(dialogue);
 		beginning = 0;
 	}
 	else if (button == GLFW_MOUSE_BUTTON_LEFT && action == GLFW_RELEASE && beginning == 100 && dragon == 0)
 	{
-		registry.remove_all_components_of(dialogue);
+		registry.destroy(dialogue);
 		dialogue = createFreeRoamLevelDiaogue(renderer, { window_width_px / 2, window_height_px - window_height_px / 3 }, (beginning - 98));
 		beginning++;
 		printf("BEGINNING IS ... %g \n", float(beginning));
 	}
 	else if (button == GLFW_MOUSE_BUTTON_LEFT && action == GLFW_RELEASE && beginning == 101 && dragon == 0)
 	{
-		registry.remove_all_components_of(dialogue);
+		registry.destroy(dialogue);
 		free_roam_tutorial = createFreeRoamLevelTutorial(renderer, vec2(window_width_px / 2, window_height_px / 2));
 		beginning = 0;
 	}
 	else if (button == GLFW_MOUSE_BUTTON_LEFT && action == GLFW_RELEASE && beginning >= 200 && beginning <= 201 && dragon == 0)
 	{
-		registry.remove_all_components_of(dialogue);
+		registry.destroy(dialogue);
 		dialogue = createFreeRoamLevelDiaogue(renderer, { window_width_px / 2, window_height_px - window_height_px / 3 }, (beginning - 193));
 		beginning++;
 	}
 	else if (button == GLFW_MOUSE_BUTTON_LEFT && action == GLFW_RELEASE && beginning == 202 && dragon == 0)
 	{
-		registry.remove_all_components_of(dialogue);
+		registry.destroy(dialogue);
 		beginning = 0;
 	}
 	else if (button == GLFW_MOUSE_BUTTON_LEFT && action == GLFW_RELEASE && !canStep && dragon == 1)
 	{
-		registry.remove_all_components_of(dialogue);
+		registry.destroy(dialogue);
 		dragon = 0;
 		canStep = 1;
 		restart_game(false);
 	}
 	else if (button == GLFW_MOUSE_BUTTON_LEFT && action == GLFW_RELEASE && !canStep && dragon == 2)
 	{
-		registry.remove_all_components_of(dialogue);
+		registry.destroy(dialogue);
 		dialogue = createFreeRoamLevelDiaogue(renderer, { window_width_px / 2, window_height_px - window_height_px / 3 }, (dragon + 3));
 		dragon++;
 	}
 	else if (button == GLFW_MOUSE_BUTTON_LEFT && action == GLFW_RELEASE && !canStep && dragon == 3)
 	{
-		registry.remove_all_components_of(dialogue);
+		registry.destroy(dialogue);
 		dragon = 0;
 		canStep = 1;
 		restart_game(false);
@@ -3238,7 +3227,7 @@ void WorldSystem::on_mouse_button(int button, int action, int mods)
 			} else {
 				exit_game_button = createUIButton(renderer, {menu_motion.position.x + menu_motion.scale.x / 2, menu_motion.position.y + menu_motion.scale.y / 3 + UI_BUTTON_HEIGHT}, EXIT_GAME);
 			}
-			registry.motions.get(exit_game_button).scale = {200, 80};
+			registry.motions.get_mut(exit_game_button).scale = {200, 80};
 			pauseMenuOpened = 1;
 			registry.renderRequests.get(open_menu_button).used_texture = TEXTURE_ASSET_ID::CLOSE_MENU;
 		}
@@ -3266,8 +3255,8 @@ void WorldSystem::on_mouse_button(int button, int action, int mods)
 				// HIDE MENU OPTIONS
 				registry.renderRequests.get(open_menu_button).used_texture = TEXTURE_ASSET_ID::OPEN_MENU;
 				// Clear on-screen buttons
-				registry.remove_all_components_of(save_game_button);
-				registry.remove_all_components_of(exit_game_button);
+				registry.destroy(save_game_button);
+				registry.destroy(exit_game_button);
 				pauseMenuOpened = 0;
 			}
 		}
@@ -3490,7 +3479,7 @@ void WorldSystem::on_mouse_button(int button, int action, int mods)
 
 			if (curr_tutorial_box_num == 7)
 			{
-				registry.remove_all_components_of(curr_tutorial_box);
+				registry.destroy(curr_tutorial_box);
 				curr_tutorial_box_num += 1;
 				tutorial_enabled = 0;
 			}
@@ -3520,7 +3509,7 @@ void WorldSystem::on_mouse_button(int button, int action, int mods)
 				arrow.counter_ms = 525.f;
 				arrow.old_pos = msPos;
 				
-				auto& motion = registry.motions.get(player_archer);
+				auto& motion = registry.motions.get_mut(player_archer);
 
 				if (motion.velocity.x != 0 && motion.velocity.y == 0) {
 					registry.companions.get(player_archer).curr_anim_type = WALK_ATTACKING;
@@ -3547,7 +3536,7 @@ void WorldSystem::on_mouse_button(int button, int action, int mods)
 				companion_size++;
 				*placeSelections(companion_size, 1) = createPlayerArcher(renderer, checkPositions(companion_size, 1), 0);
 				Entity entity = *placeSelections(companion_size, 1);
-				Statistics& stat = registry.stats.get(entity);
+				Statistics& stat = registry.stats.get_mut(entity);
 				stat.speed = player_archer_speed;
 				player_archer_speed++;
 				updateSize();
@@ -3561,7 +3550,7 @@ void WorldSystem::on_mouse_button(int button, int action, int mods)
 				companion_size++;
 				*placeSelections(companion_size, 1) = createPlayerMage(renderer, checkPositions(companion_size, 1));
 				Entity entity = *placeSelections(companion_size, 1);
-				Statistics& stat = registry.stats.get(entity);
+				Statistics& stat = registry.stats.get_mut(entity);
 				stat.speed = player_mage_speed;
 				player_mage_speed++;
 				updateSize();
@@ -3574,7 +3563,7 @@ void WorldSystem::on_mouse_button(int button, int action, int mods)
 			companion_size++;
 			*placeSelections(companion_size, 1) = createPlayerSwordsman(renderer, checkPositions(companion_size, 1));
 			Entity entity = *placeSelections(companion_size, 1);
-			Statistics& stat = registry.stats.get(entity);
+			Statistics& stat = registry.stats.get_mut(entity);
 			stat.speed = player_swordsman_speed;
 			player_swordsman_speed++;
 			updateSize();
@@ -3587,7 +3576,7 @@ void WorldSystem::on_mouse_button(int button, int action, int mods)
 			enemy_size++;
 			*placeSelections(enemy_size, 2) = createEnemyMage(renderer, checkPositions(enemy_size, 2));
 			Entity entity = *placeSelections(enemy_size, 2);
-			Statistics& stat = registry.stats.get(entity);
+			Statistics& stat = registry.stats.get_mut(entity);
 			stat.speed = enemy_mage_speed;
 			enemy_mage_speed++;
 			updateSize();
@@ -3600,7 +3589,7 @@ void WorldSystem::on_mouse_button(int button, int action, int mods)
 				enemy_size++;
 				*placeSelections(enemy_size, 2) = createEnemySwordsman(renderer, checkPositions(enemy_size, 2));
 				Entity entity = *placeSelections(enemy_size, 2);
-				Statistics& stat = registry.stats.get(entity);
+				Statistics& stat = registry.stats.get_mut(entity);
 				stat.speed = enemy_swordsman_speed;
 				enemy_swordsman_speed++;
 				updateSize();
@@ -3617,9 +3606,9 @@ void WorldSystem::on_mouse_button(int button, int action, int mods)
 			enemy_size += 3;
 			*placeSelections(enemy_size, 2) = createNecromancerPhaseOne(renderer, checkPositions(enemy_size-2, 2));
 			Entity entity = *placeSelections(enemy_size, 2);
-			Motion& motion = registry.motions.get(entity);
+			Motion& motion = registry.motions.get_mut(entity);
 			motion.position.x = motion.position.x - offset_x;
-			Statistics& stat = registry.stats.get(entity);
+			Statistics& stat = registry.stats.get_mut(entity);
 			stat.speed = necro_one_speed;
 			updateSize();
 			checkIfReady();
@@ -3631,7 +3620,7 @@ void WorldSystem::on_mouse_button(int button, int action, int mods)
 			enemy_size += 3;
 			*placeSelections(enemy_size, 2) = createNecromancerPhaseTwo(renderer, checkPositions(enemy_size-1, 2));
 			Entity entity = *placeSelections(enemy_size, 2);
-			Statistics& stat = registry.stats.get(entity);
+			Statistics& stat = registry.stats.get_mut(entity);
 			stat.speed = necro_two_speed;
 			updateSize();
 			checkIfReady();
@@ -3651,54 +3640,54 @@ void WorldSystem::on_mouse_button(int button, int action, int mods)
 
 					if(registry.companions.has(companionPosOne)){
 						Companion& comp = registry.companions.get(companionPosOne);
-						registry.remove_all_components_of(comp.healthbar);
-						registry.remove_all_components_of(companionPosOne);
+						registry.destroy(comp.healthbar);
+						registry.destroy(companionPosOne);
 					}
 
 					if(registry.companions.has(companionPosTwo)){
 						Companion& comp = registry.companions.get(companionPosTwo);
-						registry.remove_all_components_of(comp.healthbar);
-						registry.remove_all_components_of(companionPosTwo);
+						registry.destroy(comp.healthbar);
+						registry.destroy(companionPosTwo);
 					}
 
 					if(registry.companions.has(companionPosThree)){
 						Companion& comp = registry.companions.get(companionPosThree);
-						registry.remove_all_components_of(comp.healthbar);
-						registry.remove_all_components_of(companionPosThree);
+						registry.destroy(comp.healthbar);
+						registry.destroy(companionPosThree);
 					}
 
 					if(registry.companions.has(companionPosFour)){
 						Companion& comp = registry.companions.get(companionPosFour);
-						registry.remove_all_components_of(comp.healthbar);
-						registry.remove_all_components_of(companionPosFour);
+						registry.destroy(comp.healthbar);
+						registry.destroy(companionPosFour);
 					}
 
 					if(registry.enemies.has(enemyPosOne)){
 						Enemy& enemy = registry.enemies.get(enemyPosOne);
-						registry.remove_all_components_of(enemy.healthbar);
-						registry.remove_all_components_of(enemyPosOne);
+						registry.destroy(enemy.healthbar);
+						registry.destroy(enemyPosOne);
 					}
 
 					if(registry.enemies.has(enemyPosTwo)){
 						Enemy& enemy = registry.enemies.get(enemyPosTwo);
-						registry.remove_all_components_of(enemy.healthbar);
-						registry.remove_all_components_of(enemyPosTwo);
+						registry.destroy(enemy.healthbar);
+						registry.destroy(enemyPosTwo);
 					}
 
 					if(registry.enemies.has(enemyPosThree)){
 						Enemy& enemy = registry.enemies.get(enemyPosThree);
-						registry.remove_all_components_of(enemy.healthbar);
-						registry.remove_all_components_of(enemyPosThree);
+						registry.destroy(enemy.healthbar);
+						registry.destroy(enemyPosThree);
 					}
 
 					if(registry.enemies.has(enemyPosFour)){
 						Enemy& enemy = registry.enemies.get(enemyPosFour);
-						registry.remove_all_components_of(enemy.healthbar);
-						registry.remove_all_components_of(enemyPosFour);
+						registry.destroy(enemy.healthbar);
+						registry.destroy(enemyPosFour);
 					}
 
 					if (registry.renderRequests.has(startGameButton)) {
-						registry.remove_all_components_of(startGameButton);
+						registry.destroy(startGameButton);
 					}
 					isReady = false;
 					isReset = false;
@@ -3709,67 +3698,67 @@ void WorldSystem::on_mouse_button(int button, int action, int mods)
 
 		if (isReady) {
 			if (inButton(registry.motions.get(startGameButton).position, UI_BUTTON_WIDTH, UI_BUTTON_HEIGHT)) {
-				registry.remove_all_components_of(selectPanel);
-				registry.remove_all_components_of(companionSize);
-				registry.remove_all_components_of(enemySize);
-				registry.remove_all_components_of(selectArcher);
-				registry.remove_all_components_of(selectMage);
-				registry.remove_all_components_of(selectSwordsman);
-				registry.remove_all_components_of(selectEnemyMage);
-				registry.remove_all_components_of(selectEnemySwordsman);
-				registry.remove_all_components_of(selectNecroOne);
-				registry.remove_all_components_of(selectNecroTwo);
-				registry.remove_all_components_of(startGameButton);
-				registry.remove_all_components_of(resetGameButton);
+				registry.destroy(selectPanel);
+				registry.destroy(companionSize);
+				registry.destroy(enemySize);
+				registry.destroy(selectArcher);
+				registry.destroy(selectMage);
+				registry.destroy(selectSwordsman);
+				registry.destroy(selectEnemyMage);
+				registry.destroy(selectEnemySwordsman);
+				registry.destroy(selectNecroOne);
+				registry.destroy(selectNecroTwo);
+				registry.destroy(startGameButton);
+				registry.destroy(resetGameButton);
 
 				
 				if (registry.renderRequests.has(companionPosOne)) {
-					Motion& motion = registry.motions.get(companionPosOne);
+					Motion& motion = registry.motions.get_mut(companionPosOne);
 					motion.position.y = getYPosition(companionPosOne);
-					Motion& health_bar_motion = registry.motions.get(registry.companions.get(companionPosOne).healthbar);
+					Motion& health_bar_motion = registry.motions.get_mut(registry.companions.get(companionPosOne).healthbar);
 					health_bar_motion.position.y = motion.position.y - motion.scale.y/2;
 				}
 				if (registry.motions.has(companionPosTwo)) {
-					Motion& motion = registry.motions.get(companionPosTwo);
+					Motion& motion = registry.motions.get_mut(companionPosTwo);
 					motion.position.y = getYPosition(companionPosTwo);
-					Motion& health_bar_motion = registry.motions.get(registry.companions.get(companionPosTwo).healthbar);
+					Motion& health_bar_motion = registry.motions.get_mut(registry.companions.get(companionPosTwo).healthbar);
 					health_bar_motion.position.y = motion.position.y - motion.scale.y/2;
 				}
 				if (registry.motions.has(companionPosThree)) {
-					Motion& motion = registry.motions.get(companionPosThree);
+					Motion& motion = registry.motions.get_mut(companionPosThree);
 					motion.position.y = getYPosition(companionPosThree);
-					Motion& health_bar_motion = registry.motions.get(registry.companions.get(companionPosThree).healthbar);
+					Motion& health_bar_motion = registry.motions.get_mut(registry.companions.get(companionPosThree).healthbar);
 					health_bar_motion.position.y = motion.position.y - motion.scale.y/2;
 				}
 				if (registry.motions.has(companionPosFour)) {
-					Motion& motion = registry.motions.get(companionPosFour);
+					Motion& motion = registry.motions.get_mut(companionPosFour);
 					motion.position.y = getYPosition(companionPosFour);
-					Motion& health_bar_motion = registry.motions.get(registry.companions.get(companionPosFour).healthbar);
+					Motion& health_bar_motion = registry.motions.get_mut(registry.companions.get(companionPosFour).healthbar);
 					health_bar_motion.position.y = motion.position.y - motion.scale.y/2;
 				}
 				if (registry.motions.has(enemyPosOne)) {
-					Motion& motion = registry.motions.get(enemyPosOne);
+					Motion& motion = registry.motions.get_mut(enemyPosOne);
 					motion.position.y = getYPosition(enemyPosOne);
-					Motion& health_bar_motion = registry.motions.get(registry.enemies.get(enemyPosOne).healthbar);
+					Motion& health_bar_motion = registry.motions.get_mut(registry.enemies.get(enemyPosOne).healthbar);
 					health_bar_motion.position.y = motion.position.y - motion.scale.y/2;
 				}
 				if (registry.motions.has(enemyPosTwo)) {
-					Motion& motion = registry.motions.get(enemyPosTwo);
+					Motion& motion = registry.motions.get_mut(enemyPosTwo);
 					motion.position.y = getYPosition(enemyPosTwo);
-					Motion& health_bar_motion = registry.motions.get(registry.enemies.get(enemyPosTwo).healthbar);
+					Motion& health_bar_motion = registry.motions.get_mut(registry.enemies.get(enemyPosTwo).healthbar);
 					health_bar_motion.position.y = motion.position.y - motion.scale.y/2;
 				}
 				if (registry.motions.has(enemyPosThree)) {
-					Motion& motion = registry.motions.get(enemyPosThree);
+					Motion& motion = registry.motions.get_mut(enemyPosThree);
 					motion.position.y = getYPosition(enemyPosThree);
-					Motion& health_bar_motion = registry.motions.get(registry.enemies.get(enemyPosThree).healthbar);
+					Motion& health_bar_motion = registry.motions.get_mut(registry.enemies.get(enemyPosThree).healthbar);
 					health_bar_motion.position.y = motion.position.y - motion.scale.y/2;
 				 }
 
 				if (registry.renderRequests.has(enemyPosFour)) {
-					Motion& motion = registry.motions.get(enemyPosFour);
+					Motion& motion = registry.motions.get_mut(enemyPosFour);
 					motion.position.y = getYPosition(enemyPosFour);
-					Motion& health_bar_motion = registry.motions.get(registry.enemies.get(enemyPosFour).healthbar);
+					Motion& health_bar_motion = registry.motions.get_mut(registry.enemies.get(enemyPosFour).healthbar);
 					health_bar_motion.position.y = motion.position.y - motion.scale.y/2;
 				}
 
@@ -3791,12 +3780,12 @@ void WorldSystem::on_mouse_button(int button, int action, int mods)
 			fprintf(stderr, "click on yes");
 
 			while (registry.motions.entities.size() > 0)
-				registry.remove_all_components_of(registry.motions.entities.back());
+				registry.destroy(registry.motions.entities.back());
 			while (registry.renderRequests.entities.size() > 0)
-				registry.remove_all_components_of(registry.renderRequests.entities.back());
+				registry.destroy(registry.renderRequests.entities.back());
 			if (registry.charIndicator.components.size() != 0)
 			{
-				registry.remove_all_components_of(registry.charIndicator.entities[0]);
+				registry.destroy(registry.charIndicator.entities[0]);
 			}
 			// Debugging for memory/component leaks
 			registry.list_all_components();
@@ -3854,7 +3843,7 @@ void WorldSystem::advanceTutorial(Entity currTutorial, vec2 pos)
 
 	// Change box location
 	if (registry.motions.has(currTutorial)) {
-		Motion& motion = registry.motions.get(currTutorial);
+		Motion& motion = registry.motions.get_mut(currTutorial);
 		motion.position = (pos.x != -1) ? pos : next_box_pos;
 	}
 
@@ -4021,7 +4010,7 @@ void WorldSystem::on_mouse_move(vec2 mouse_position)
 		}
 		else
 		{
-			registry.remove_all_components_of(tooltip);
+			registry.destroy(tooltip);
 			registry.toolTip.clear();
 		}
 	}
@@ -4064,10 +4053,10 @@ void WorldSystem::on_mouse_move(vec2 mouse_position)
 			}
 		}
 		else {
-			registry.remove_all_components_of(hoverBoxTop);
-			registry.remove_all_components_of(hoverBoxBottom);
-			registry.remove_all_components_of(hoverBoxLeft);
-			registry.remove_all_components_of(hoverBoxRight);
+			registry.destroy(hoverBoxTop);
+			registry.destroy(hoverBoxBottom);
+			registry.destroy(hoverBoxLeft);
+			registry.destroy(hoverBoxRight);
 		}
 	}
 
@@ -4151,7 +4140,7 @@ bool WorldSystem::inEntity(const Entity entity)
 
 void WorldSystem::deselectButton()
 {
-	registry.remove_all_components_of(selectedButton);
+	registry.destroy(selectedButton);
 }
 
 void WorldSystem::deselectButtons()
@@ -4160,7 +4149,7 @@ void WorldSystem::deselectButtons()
 	{
 		FIREBALLSELECTED = 0;
 		SILENCESELECTED = 0;
-		registry.remove_all_components_of(selectedButton);
+		registry.destroy(selectedButton);
 	}
 }
 
@@ -4300,7 +4289,8 @@ void WorldSystem::initializeFreeRoamTwo() {
 	createTreasureChest(renderer, { 100, 350 - PLATFORM_HEIGHT }, HEALTH_BOOST);
 	createTreasureChest(renderer, { 1100, 225 - PLATFORM_HEIGHT }, DAMAGE_BOOST);
 
-	if (swarmSys->swarmInitialized) {
+	// The fireflies are removed with the other motion entities on restart, re-create them in that case
+	if (swarmSys->swarmInitialized && registry.fireflySwarm.size() >= NUM_SWARM_PARTICLES) {
 		swarmSys->resetSwarm();
 	}
 	else {
@@ -15,6 +15,7 @@
 #include "render_system.hpp"
 #include "skill_system.hpp"
 #include "swarm_system.hpp"
+#include "command_buffer.hpp"
 
 // Container for all our entities and game logic. Individual rendering / update is
 // deferred to the relative update() methods
@@ -107,7 +108,7 @@ private:
 	// Helper function for updating health in collision
 	void update_health(Entity entity, Entity other_entity);
 
-	// Updates all healthbars
+	// Updates the healthbars of the characters whose statistics changed since the last call
 	void update_healthBars();
 
 	// restart level
@@ -163,6 +164,15 @@ private:
 	SkillSystem* sk;
 	SwarmSystem* swarmSys;
 
+	// Entity removals of a step, applied together once the step has decided what goes
+	CommandBuffer commands;
+
+	// registry.stats change tick at the last update_healthBars
+	unsigned int healthbar_tick = 0;
+
+	// Level whose component capacities are recorded on the next restart, see JSONLoader::save_capacity_profile
+	std::string capacity_profile_level;
+
 	float current_speed;
 	
 	Entity arrow_mesh;
@@ -0,0 +1,183 @@
+// Tests of the component containers, build the windfall_ecs_tests target and run it through ctest
+// Every failed check is printed, the exit code is non-zero if any check failed.
+
+// stlib
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+// internal
+#include "tiny_ecs.hpp"
+
+static int failures = 0;
+
+// Unlike assert, the checks also run in release builds
+#define CHECK(condition) \
+	do { \
+		if (!(condition)) { \
+			printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+			failures++; \
+		} \
+	} while (0)
+
+struct TestComponent
+{
+	unsigned int value = 0;
+};
+
+// A handle to a destroyed entity must not see the components of the next owner of its index
+static void test_stale_handle()
+{
+	ComponentContainer<TestComponent> container;
+	Entity old_handle(7, 1);
+	container.emplace(old_handle).value = 1;
+	container.remove(old_handle);
+
+	Entity new_handle(7, 2);
+	container.emplace(new_handle).value = 2;
+	CHECK(container.has(new_handle));
+	CHECK(!container.has(old_handle));
+	CHECK(!container.changed_since(old_handle, 0));
+
+	// Removing through the stale handle leaves the new owner alone
+	container.remove(old_handle);
+	CHECK(container.has(new_handle));
+	CHECK(container.get(new_handle).value == 2);
+
+	// The null handle never owns components
+	CHECK(!container.has(Entity()));
+}
+
+// The generation wraps around within its bits and never spills into the index
+static void test_generation_wraparound()
+{
+	unsigned int index = Entity::index_mask;
+	Entity last(index, Entity::generation_mask);
+	CHECK(last.index() == index);
+	CHECK(last.generation() == Entity::generation_mask);
+
+	Entity wrapped(index, Entity::generation_mask + 1);
+	CHECK(wrapped.index() == index);
+	CHECK(wrapped.generation() == 0);
+	CHECK(wrapped != last);
+
+	// Both ends of the generation range are told apart by the containers
+	ComponentContainer<TestComponent> container;
+	container.emplace(last).value = 3;
+	CHECK(container.has(last));
+	CHECK(!container.has(wrapped));
+}
+
+// Sorting permutes the components with their entities and keeps their change ticks
+static void test_sort_permutation()
+{
+	ComponentContainer<TestComponent> container;
+	const unsigned int n = 100;
+	for (unsigned int i = 1; i <= n; i++)
+		container.emplace(Entity((i * 37) % 101, 1)).value = (i * 37) % 101;
+	unsigned int since = container.current_tick();
+	Entity modified(37, 1);
+	container.get_mut(modified);
+	unsigned int version = container.structure_version();
+
+	container.sort([](Entity a, Entity b) { return a.index() > b.index(); });
+	CHECK(container.structure_version() != version);
+	CHECK(container.components.size() == n);
+	for (unsigned int i = 0; i < container.entities.size(); i++)
+	{
+		Entity e = container.entities[i];
+		CHECK(i == 0 || container.entities[i - 1].index() > e.index());
+		CHECK(container.components[i].value == e.index());
+		CHECK(container.get(e).value == e.index());
+	}
+
+	std::vector<Entity> changed;
+	container.each_changed(since, [&](Entity e, TestComponent&) { changed.push_back(e); });
+	CHECK(changed.size() == 1 && changed[0] == modified);
+}
+
+// each_changed and changed_since report the components inserted or accessed through get_mut/patch after a tick
+static void test_each_changed()
+{
+	ComponentContainer<TestComponent> container;
+	Entity a(1, 1), b(2, 1), c(3, 1);
+	container.emplace(a);
+	container.emplace(b);
+	unsigned int since = container.current_tick();
+
+	// Plain reads do not count as changes
+	container.get(a);
+	unsigned int calls = 0;
+	container.each_changed(since, [&](Entity, TestComponent&) { calls++; });
+	CHECK(calls == 0);
+	CHECK(!container.changed_since(a, since));
+
+	container.patch(b, [](TestComponent& component) { component.value = 5; });
+	container.emplace(c);
+	std::vector<Entity> changed;
+	container.each_changed(since, [&](Entity e, TestComponent&) { changed.push_back(e); });
+	std::sort(changed.begin(), changed.end());
+	CHECK(changed == std::vector<Entity>({ b, c }));
+	CHECK(!container.changed_since(a, since));
+	CHECK(container.changed_since(b, since));
+
+	// Removing a component moves the last one into its place, the change tick moves with it
+	container.remove(a);
+	CHECK(container.changed_since(c, since));
+	CHECK(!container.changed_since(a, since));
+}
+
+// drain_changes passes the logged entities that still have a component, once per drain
+static void test_drain_changes()
+{
+	ComponentContainer<TestComponent> container;
+	Entity a(1, 1), b(2, 1), c(3, 1);
+	container.emplace(a);
+	container.track_changes();
+
+	// The entities present when tracking starts are logged
+	std::vector<Entity> drained;
+	auto drain = [&]() {
+		drained.clear();
+		container.drain_changes([&](Entity e) { drained.push_back(e); });
+		std::sort(drained.begin(), drained.end());
+	};
+	drain();
+	CHECK(drained == std::vector<Entity>({ a }));
+	drain();
+	CHECK(drained.empty());
+
+	// Repeated writes between two drains log an entity once, reads do not log it
+	container.emplace(b);
+	container.get_mut(a);
+	container.get_mut(a);
+	container.get(b);
+	drain();
+	CHECK(drained == std::vector<Entity>({ a, b }));
+
+	// Removed entities are skipped, also when their index got a new generation
+	container.emplace(c);
+	container.get_mut(b);
+	container.remove(b);
+	container.remove(c);
+	container.emplace(Entity(3, 2));
+	drain();
+	CHECK(drained == std::vector<Entity>({ Entity(3, 2) }));
+}
+
+int main()
+{
+	test_stale_handle();
+	test_generation_wraparound();
+	test_sort_permutation();
+	test_each_changed();
+	test_drain_changes();
+	if (failures > 0)
+	{
+		printf("%d checks failed\n", failures);
+		return EXIT_FAILURE;
+	}
+	printf("All checks passed\n");
+	return EXIT_SUCCESS;
+}